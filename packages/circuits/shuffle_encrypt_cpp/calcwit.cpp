@@ -1,9 +1,18 @@
 #include <iomanip>
 #include <sstream>
 #include <assert.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include "calcwit.hpp"
 
 extern void run(Circom_CalcWit* ctx);
+extern bool precompute(Circom_CalcWit* ctx);
+extern Circom_TemplateFunction _functionTable[];
+extern Circom_TemplateFunction _functionTableParallel[];
+extern Circom_ComponentName componentNames[];
+extern Circom_TemplateArena templateArenas[];
 
 std::string int_to_hex( u64 i )
 {
@@ -23,7 +32,40 @@ u64 fnv1a(std::string s) {
   return hash;
 }
 
+size_t Circom_CalcWit::getComponentArenaSize() {
+  // Subcomponents have a smaller template id than the templates creating
+  // them, so instances are final once all the larger ids are visited. The
+  // main component is the only one no template creates.
+  uint nTemplates = get_number_of_templates();
+  std::vector<u64> instances(nTemplates, 0);
+  std::vector<bool> created(nTemplates, false);
+  for (uint t = 0; t < nTemplates; t++) {
+    for (uint j = 0; j < templateArenas[t].subcomponentsSize; j++) {
+      uint sub = templateArenas[t].subcomponents[2*j];
+      if (sub >= t) {
+        throw std::runtime_error("Invalid template table: template " + std::to_string(t) + " creates template " + std::to_string(sub) + "\n");
+      }
+      created[sub] = true;
+    }
+  }
+  u64 nComponents = 0;
+  size_t size = 0;
+  for (uint t = nTemplates; t-- > 0; ) {
+    if (!created[t]) instances[t] = 1;
+    nComponents += instances[t];
+    size += instances[t] * templateArenas[t].arenaSize;
+    for (uint j = 0; j < templateArenas[t].subcomponentsSize; j++) {
+      instances[templateArenas[t].subcomponents[2*j]] += instances[t] * templateArenas[t].subcomponents[2*j+1];
+    }
+  }
+  if (nComponents != get_number_of_components()) {
+    throw std::runtime_error("Invalid template table: " + std::to_string(nComponents) + " components instead of " + std::to_string(get_number_of_components()) + "\n");
+  }
+  return size;
+}
+
 Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
+  componentArenaSize = getComponentArenaSize();
   circuit = aCircuit;
   inputSignalAssignedCounter = get_main_input_signal_no();
   inputSignalAssigned = new bool[inputSignalAssignedCounter];
@@ -33,21 +75,43 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
   signalValues = new FrElement[get_total_signal_no()];
   Fr_str2element(&signalValues[0], "1", 10);
   componentMemory = new Circom_Component[get_number_of_components()];
+  componentArena = new u8[componentArenaSize]();
+  componentArenaUsed = 0;
+  precomputed = false;
+  sharedInstances = new std::atomic<u32>[get_number_of_templates()];
+  for (uint i = 0; i < get_number_of_templates(); i++) {
+    sharedInstances[i] = 0;
+  }
   circuitConstants = circuit ->circuitConstants;
   templateInsId2IOSignalInfo = circuit -> templateInsId2IOSignalInfo;
 
   maxThread = maxTh;
-
-  // parallelism
-  numThread = 0;
-
+  pool = maxThread > 1 ? new Circom_TaskPool(maxThread) : NULL;
 }
 
 Circom_CalcWit::~Circom_CalcWit() {
-  // ...
+  delete pool;
+  delete [] inputSignalAssigned;
+  delete [] signalValues;
+  delete [] componentMemory;
+  delete [] componentArena;
+  delete [] sharedInstances;
 }
 
-uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
+void Circom_CalcWit::reset() {
+  memset(componentArena, 0, componentArenaUsed);
+  componentArenaUsed = 0;
+  precomputed = false;
+  for (uint i = 0; i < get_number_of_templates(); i++) {
+    sharedInstances[i] = 0;
+  }
+  inputSignalAssignedCounter = get_main_input_signal_no();
+  for (uint i = 0; i < inputSignalAssignedCounter; i++) {
+    inputSignalAssigned[i] = false;
+  }
+}
+
+int Circom_CalcWit::findInputSignal(u64 h) {
   uint n = get_size_of_input_hashmap();
   uint pos = (uint)(h % (u64)n);
   if (circuit->InputHashMap[pos].hash!=h){
@@ -55,13 +119,18 @@ uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
     pos = (pos+1)%n; 
     while (pos != inipos) {
       if (circuit->InputHashMap[pos].hash == h) return pos;
-      if (circuit->InputHashMap[pos].signalid == 0) {
-	fprintf(stderr, "Signal not found\n");
-	assert(false);
-      }
+      if (circuit->InputHashMap[pos].signalid == 0) return -1;
       pos = (pos+1)%n; 
     }
-    fprintf(stderr, "Signals not found\n");
+    return -1;
+  }
+  return pos;
+}
+
+uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
+  int pos = findInputSignal(h);
+  if (pos < 0) {
+    fprintf(stderr, "Signal not found\n");
     assert(false);
   }
   return pos;
@@ -73,6 +142,11 @@ void Circom_CalcWit::tryRunCircuit(){
   }
 }
 
+bool Circom_CalcWit::precomputeCircuit() {
+  if (precomputed || inputSignalAssignedCounter == 0) return false;
+  return precompute(this);
+}
+
 void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
   if (inputSignalAssignedCounter == 0) {
     fprintf(stderr, "No more signals to be assigned\n");
@@ -95,21 +169,57 @@ void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
   tryRunCircuit();
 }
 
+PFrElement Circom_CalcWit::getInputSignalValues(u64 h) {
+  uint pos = getInputSignalHashPosition(h);
+  return &signalValues[circuit->InputHashMap[pos].signalid];
+}
+
+void Circom_CalcWit::setInputSignalAssigned(u64 h) {
+  uint pos = getInputSignalHashPosition(h);
+  uint si = circuit->InputHashMap[pos].signalid;
+  uint n = circuit->InputHashMap[pos].signalsize;
+  if (inputSignalAssignedCounter < n) {
+    fprintf(stderr, "No more signals to be assigned\n");
+    assert(false);
+  }
+  for (uint i = 0; i < n; i++) {
+    if (inputSignalAssigned[si+i-get_main_input_signal_start()]) {
+      fprintf(stderr, "Signal assigned twice: %d\n", si+i);
+      assert(false);
+    }
+    inputSignalAssigned[si+i-get_main_input_signal_start()] = true;
+  }
+  inputSignalAssignedCounter -= n;
+}
+
+void Circom_CalcWit::setInputSignalsAssigned() {
+  for (uint i = 0; i < get_main_input_signal_no(); i++) {
+    if (inputSignalAssigned[i]) {
+      fprintf(stderr, "Signal assigned twice: %d\n", i+get_main_input_signal_start());
+      assert(false);
+    }
+    inputSignalAssigned[i] = true;
+  }
+  inputSignalAssignedCounter = 0;
+}
+
 u64 Circom_CalcWit::getInputSignalSize(u64 h) {
   uint pos = getInputSignalHashPosition(h);
   return circuit->InputHashMap[pos].signalsize;
 }
 
 std::string Circom_CalcWit::getTrace(u64 id_cmp){
-  if (id_cmp == 0) return componentMemory[id_cmp].componentName;
+  Circom_ComponentName &name = componentNames[componentMemory[id_cmp].componentNameId];
+  std::string my_name = name.name;
+  if (name.dimensionsSize > 0) {
+    my_name += generate_position_array(name.dimensions, name.dimensionsSize, componentMemory[id_cmp].componentPosition);
+  }
+  if (id_cmp == 0) return my_name;
   else{
     u64 id_father = componentMemory[id_cmp].idFather;
-    std::string my_name = componentMemory[id_cmp].componentName;
 
     return Circom_CalcWit::getTrace(id_father) + "." + my_name;
   }
-
-
 }
 
 std::string Circom_CalcWit::generate_position_array(uint* dimensions, uint size_dimensions, uint index){
@@ -124,3 +234,73 @@ std::string Circom_CalcWit::generate_position_array(uint* dimensions, uint size_
   return positions;
 }
 
+void Circom_CalcWit::publishFixedSignals(uint templateId, u64 signalStart, uint n) {
+  if (getFixedSignals(templateId) != NULL) return;
+  FrElement *fixed = new FrElement[n];
+  memcpy(fixed, &signalValues[signalStart], n * sizeof(FrElement));
+  FrElement *none = NULL;
+  if (!circuit->fixedSignals[templateId].compare_exchange_strong(none, fixed, std::memory_order_release)) {
+    delete [] fixed;
+  }
+}
+
+void Circom_CalcWit::getWitnessLongChunk(uint chunk, Circom_CalcWit *ctx) {
+  uint nWitness = get_size_of_witness();
+  uint first = std::min(nWitness, chunk * ctx->witnessLongChunkSize);
+  uint n = std::min(nWitness - first, ctx->witnessLongChunkSize);
+  u8 *r = ctx->witnessLongOut + (size_t)first * Fr_N64 * 8;
+  if (ctx->witnessLongMontgomery) {
+    ctx->getWitnessLongMontgomery(first, n, r);
+  } else {
+    ctx->getWitnessLongNormal(first, n, r);
+  }
+  if (ctx->witnessLongDone != NULL) {
+    ctx->witnessLongDone[chunk] = true;
+  }
+}
+
+void Circom_CalcWit::getWitnessLong(u8 *r, bool montgomery) {
+  uint nChunks = pool != NULL ? maxThread : 1;
+  witnessLongOut = r;
+  witnessLongMontgomery = montgomery;
+  witnessLongChunkSize = (get_size_of_witness() + nChunks - 1) / nChunks;
+  if (nChunks == 1) {
+    witnessLongDone = NULL;
+    getWitnessLongChunk(0, this);
+    return;
+  }
+  std::vector<std::atomic<bool>> done(nChunks);
+  witnessLongDone = done.data();
+  for (uint i = 1; i < nChunks; i++) {
+    done[i] = false;
+    pool->push({getWitnessLongChunk, i, this});
+  }
+  getWitnessLongChunk(0, this);
+  for (uint i = 1; i < nChunks; i++) {
+    if (!done[i]) {
+      pool->helpUntil(done[i]);
+    }
+  }
+  witnessLongDone = NULL;
+}
+
+void Circom_CalcWit::runParallel(uint cIdx, uint slot) {
+  uint sub = componentMemory[cIdx].subcomponents[slot];
+  Circom_TemplateFunction f = _functionTableParallel[componentMemory[sub].templateId];
+  if (pool == NULL || f == NULL) {
+    _functionTable[componentMemory[sub].templateId](sub, this);
+    componentMemory[sub].hasRun = true;
+    return;
+  }
+  componentMemory[sub].hasRun = false;
+  pool->push({f, sub, this});
+}
+
+void Circom_CalcWit::joinParallel(uint cIdx, uint first, uint n) {
+  for (uint i = first; i < first + n; i++) {
+    Circom_Component &sub = componentMemory[componentMemory[cIdx].subcomponents[i]];
+    if (!sub.hasRun) {
+      pool->helpUntil(sub.hasRun);
+    }
+  }
+}
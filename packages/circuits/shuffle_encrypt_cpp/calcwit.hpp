@@ -6,9 +6,14 @@
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <assert.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "circom.hpp"
 #include "fr.hpp"
+#include "taskpool.hpp"
 
 #define NMUTEXES 32 //512
 
@@ -21,47 +26,180 @@ class Circom_CalcWit {
 
   Circom_Circuit *circuit;
 
+  u8 *componentArena;
+  size_t componentArenaSize;
+  std::atomic<size_t> componentArenaUsed;
+
+  std::atomic<u32> *sharedInstances;
+
 public:
 
   FrElement *signalValues;
   Circom_Component* componentMemory;
   FrElement* circuitConstants; 
-  std::map<u32,IODefPair> templateInsId2IOSignalInfo; 
+  IODefPair* templateInsId2IOSignalInfo; 
   std::string* listOfTemplateMessages; 
 
   // parallelism
-  std::mutex numThreadMutex;
-  std::condition_variable ntcvs;
-  int numThread;
-
   int maxThread;
+  Circom_TaskPool *pool;
 
   // Functions called by the circuit
   Circom_CalcWit(Circom_Circuit *aCircuit, uint numTh = NMUTEXES);
   ~Circom_CalcWit();
 
+  // Set by precomputeCircuit(): the subcomponents that only depend on the
+  // inputs known before the others already ran, and the circuit skips them.
+  // Cleared by reset().
+  bool precomputed;
+  // Component precomputeCircuit() fills, recorded by the generated code
+  // that creates it.
+  uint precomputedComponent;
+
   // Public functions
   void setInputSignal(u64 h, uint i, FrElement &val);
   void tryRunCircuit();
+
+  // Runs ahead the subcomponents of the circuit that only depend on inputs
+  // that are set, see precompute() in the circuit. Returns false, and does
+  // nothing, if some of the inputs they need are not set yet.
+  bool precomputeCircuit();
+
+  // Loading in place: the values of the input signal h are written straight
+  // into getInputSignalValues(h)[0 .. getInputSignalSize(h)) and count as set
+  // after setInputSignalAssigned(h), which unlike setInputSignal does not run
+  // the circuit.
+  PFrElement getInputSignalValues(u64 h);
+  void setInputSignalAssigned(u64 h);
+
+  // Position of input signal h in the input hash map, or -1 if the circuit
+  // has no such input. The other functions taking h assert that it exists;
+  // loaders check it first to report a bad key as an error.
+  int findInputSignal(u64 h);
+
+  // Prepares the context for the next witness without reallocating the
+  // signal and component memory: only the input-assigned flags are cleared
+  // and the component arena is emptied, component counters are set again by
+  // the *_create functions on run.
+  void reset();
+
+  // Zeroed array of n T from the component arena, which holds the arrays of
+  // all the components of a run and is emptied at once by reset(). Called
+  // concurrently by the *_create functions of parallel subcomponents.
+  template <class T>
+  T* allocComponentArray(uint n) {
+    size_t size = (n * sizeof(T) + 7) & ~size_t(7);
+    size_t offset = componentArenaUsed.fetch_add(size);
+    if (offset + size > componentArenaSize) {
+      fprintf(stderr, "Component arena overflow: %zu bytes needed, %zu available\n", offset + size, componentArenaSize);
+      abort();
+    }
+    return reinterpret_cast<T*>(componentArena + offset);
+  }
   
   u64 getInputSignalSize(u64 h);
 
+  // Marks all the main inputs as set, for loaders that wrote them in place.
+  // Does not run the circuit.
+  void setInputSignalsAssigned();
+
+  inline u64 getInputHash() {
+    return circuit->inputHash;
+  }
+
   inline uint getRemaingInputsToBeSet() {
     return inputSignalAssignedCounter;
   }
+
+  inline bool isInputSignalAssigned(uint si) {
+    return inputSignalAssigned[si - get_main_input_signal_start()];
+  }
   
   inline void getWitness(uint idx, PFrElement val) {
     Fr_copy(val, &signalValues[circuit->witness2SignalList[idx]]);
   }
 
+  // Writes witnesses first..first+n-1 in long normal form, 32 bytes each
+  inline void getWitnessLongNormal(uint first, uint n, u8 *r) {
+    Fr_toLongNormal_n(r, signalValues, (const uint64_t *)&circuit->witness2SignalList[first], n);
+  }
+
+  // Same as getWitnessLongNormal in Montgomery form
+  inline void getWitnessLongMontgomery(uint first, uint n, u8 *r) {
+    Fr_toLongMontgomery_n(r, signalValues, (const uint64_t *)&circuit->witness2SignalList[first], n);
+  }
+
+  // Writes the whole witness to r like getWitnessLongNormal, or
+  // getWitnessLongMontgomery if montgomery is set. The witness is split in
+  // chunks run as tasks of the pool.
+  void getWitnessLong(u8 *r, bool montgomery);
+
   std::string getTrace(u64 id_cmp);
 
   std::string generate_position_array(uint* dimensions, uint size_dimensions, uint index);
 
+  // Components that run many times with some inputs in common can take the
+  // signals that only depend on those inputs from an instance that already
+  // ran, see sharedWith. publishSharedInstance records the first finished
+  // instance cIdx of templateId, getSharedInstance returns it or 0. The
+  // caller compares the common inputs. Cleared by reset().
+  inline u32 getSharedInstance(uint templateId) {
+    return sharedInstances[templateId].load(std::memory_order_acquire);
+  }
+
+  inline void publishSharedInstance(uint templateId, u32 cIdx) {
+    u32 none = 0;
+    sharedInstances[templateId].compare_exchange_strong(none, cIdx, std::memory_order_release);
+  }
+
+  // Subcomponents whose inputs only depend on constants, like the multiples
+  // of a fixed base point, have the same signals in every witness. The
+  // first finished instance of templateId publishes its signals
+  // [signalStart, signalStart + n) as the fixed signals of the template,
+  // which the circuit keeps for the next runs and contexts. Instances that
+  // find them set fixedSignals and copy those subcomponents with
+  // copyFixedSignals instead of running them.
+  inline const FrElement *getFixedSignals(uint templateId) {
+    return circuit->fixedSignals[templateId].load(std::memory_order_acquire);
+  }
+
+  void publishFixedSignals(uint templateId, u64 signalStart, uint n);
+
+  // Copies the n signals of subcomponent sub of cIdx from the fixed signals
+  // of cIdx.
+  inline void copyFixedSignals(uint cIdx, uint sub, uint n) {
+    u64 start = componentMemory[sub].signalStart;
+    const FrElement *fixed = componentMemory[cIdx].fixedSignals + (start - componentMemory[cIdx].signalStart);
+    memcpy(&signalValues[start], fixed, n * sizeof(FrElement));
+  }
+
+  // Queues the subcomponent in slot of component cIdx as a task of the
+  // pool. With maxThread <= 1 there is no pool and the subcomponent is run
+  // on the calling thread.
+  void runParallel(uint cIdx, uint slot);
+
+  // Waits for the subcomponents in slots [first, first + n) of cIdx started
+  // by runParallel, running pool tasks meanwhile. Their outputs can be read
+  // afterwards.
+  void joinParallel(uint cIdx, uint first, uint n);
+
 private:
   
   uint getInputSignalHashPosition(u64 h);
 
+  // Bytes of component arrays of a whole run: the arena size of every
+  // template times its number of instances, counted down from the main
+  // component through templateArenas. Throws if the count disagrees with
+  // get_number_of_components().
+  static size_t getComponentArenaSize();
+
+  // Chunk of the getWitnessLong call in progress, run as a pool task.
+  static void getWitnessLongChunk(uint chunk, Circom_CalcWit *ctx);
+  u8 *witnessLongOut;
+  bool witnessLongMontgomery;
+  uint witnessLongChunkSize;
+  std::atomic<bool> *witnessLongDone;
+
 };
 
 typedef void (*Circom_TemplateFunction)(uint __cIdx, Circom_CalcWit* __ctx); 
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <atomic>
 
 #include "fr.hpp"
 
@@ -36,23 +37,42 @@ struct Circom_Circuit {
   HashSignalInfo* InputHashMap;
   u64* witness2SignalList;
   FrElement* circuitConstants;  
-  std::map<u32,IODefPair> templateInsId2IOSignalInfo;
+  IODefPair* templateInsId2IOSignalInfo; // indexed by templateId
+  u64 inputHash; // of the main input layout, see loadCircuit
+  std::atomic<FrElement*> *fixedSignals; // indexed by templateId, see Circom_CalcWit::getFixedSignals
+  u8 *datData; // mapping of the .dat file the tables above point into
+  size_t datSize;
 };
 
+// Name of a subcomponent declaration, for traces. The component created at
+// position i of a declaration with dimensions is named name[..][..].
+struct Circom_ComponentName {
+  const char *name;
+  uint *dimensions;
+  uint dimensionsSize;
+};
+
+// Component arrays a template takes from the arena (see
+// Circom_CalcWit::allocComponentArray) and the subcomponents it creates, as
+// subcomponentsSize pairs (templateId, number of instances).
+struct Circom_TemplateArena {
+  uint arenaSize;
+  uint *subcomponents;
+  uint subcomponentsSize;
+};
 
 struct Circom_Component {
   u32 templateId;
   u64 signalStart;
-  u32 inputCounter;
-  std::string templateName;
-  std::string componentName;
+  std::atomic<u32> inputCounter;
+  u32 componentNameId;
+  u32 componentPosition;
   u64 idFather; 
   u32* subcomponents = NULL;
   bool* subcomponentsParallel = NULL;
-  bool *outputIsSet = NULL;  //one for each output
-  std::mutex *mutexes = NULL;  //one for each output
-  std::condition_variable *cvs = NULL;
-  std::thread *sbct = NULL;//subcomponent threads
+  std::atomic<bool> hasRun;//set by *_run_parallel, for Circom_CalcWit::joinParallel
+  u32 sharedWith = 0; //instance of the same component that already ran with the same shared inputs, or 0
+  const FrElement *fixedSignals = NULL; //signals of the component in an earlier run, for the ones fixed by the constants
 };
 
 /*
@@ -77,6 +97,7 @@ uint get_main_input_signal_start();
 uint get_main_input_signal_no();
 uint get_total_signal_no();
 uint get_number_of_components();
+uint get_number_of_templates();
 uint get_size_of_input_hashmap();
 uint get_size_of_witness();
 uint get_size_of_constants();
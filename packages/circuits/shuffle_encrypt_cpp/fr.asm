@@ -38,6 +38,7 @@
         global Fr_rawNeg
         global Fr_rawMMul
         global Fr_rawMSquare
+        global Fr_rawMMul1
         global Fr_rawToMontgomery
         global Fr_rawFromMontgomery
         global Fr_rawIsEq
@@ -3,7 +3,9 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <assert.h>
+#include <string.h>
 #include <string>
+#include <immintrin.h>
 
 
 static mpz_t q;
@@ -53,33 +55,163 @@ bool Fr_init() {
     return true;
 }
 
-void Fr_str2element(PFrElement pE, char const *s, uint base) {
-    mpz_t mr;
-    mpz_init_set_str(mr, s, base);
-    mpz_fdiv_r(mr, mr, q);
-    Fr_fromMpz(pE, mr);
-    mpz_clear(mr);
+/*
+String conversions without GMP. Digits are read in chunks that fit in a
+u64 and accumulated exactly in 4 limbs, with a final conditional reduction
+below q; only numbers wider than 256 bits are accumulated mod q with a
+Montgomery multiplication per chunk. Printing divides 32-bit limbs by the
+largest power of the base that fits in 32 bits.
+*/
+
+static inline int Fr_digitValue(char c) {
+    if ('0' <= c && c <= '9') return c - '0';
+    if ('a' <= c && c <= 'z') return c - 'a' + 10;
+    if ('A' <= c && c <= 'Z') return c - 'A' + 10;
+    return 36;
 }
 
-char *Fr_element2str(PFrElement pE) {
-    FrElement tmp;
-    mpz_t r;
-    if (!(pE->type & Fr_LONG)) {
-        if (pE->shortVal>=0) {
-            char *r = new char[32];
-            sprintf(r, "%d", pE->shortVal);
-            return r;
-        } else {
-            mpz_init_set_si(r, pE->shortVal);
-            mpz_add(r, r, q);
+static inline bool Fr_rawGeq(const FrRawElement a, const FrRawElement b) {
+    for (int i=Fr_N64-1; i>=0; i--) {
+        if (a[i] != b[i]) return a[i] > b[i];
+    }
+    return true;
+}
+
+static inline void Fr_rawSubNoMod(FrRawElement r, const FrRawElement a, const FrRawElement b) {
+    uint64_t borrow = 0;
+    for (int i=0; i<Fr_N64; i++) {
+        unsigned __int128 d = (unsigned __int128)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+}
+
+bool Fr_rawFromDigits(FrRawElement r, const char *digits, size_t n, uint base) {
+    if (n == 0 || base < 2 || base > 36) return false;
+    uint chunkDigits = 0;
+    for (uint64_t p = 1; p <= UINT64_MAX / base; p *= base) chunkDigits++;
+
+    bool exact = true;
+    FrRawElement t, aux;
+    r[0] = r[1] = r[2] = r[3] = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t end = i + chunkDigits < n ? i + chunkDigits : n;
+        uint64_t chunk = 0;
+        uint64_t scale = 1;
+        for (; i < end; i++) {
+            uint d = Fr_digitValue(digits[i]);
+            if (d >= base) return false;
+            chunk = chunk * base + d;
+            scale *= base;
+        }
+        if (exact) {
+            // r * scale + chunk while it fits in 256 bits
+            unsigned __int128 carry = chunk;
+            for (int j=0; j<Fr_N64; j++) {
+                unsigned __int128 p = (unsigned __int128)r[j] * scale + carry;
+                t[j] = (uint64_t)p;
+                carry = p >> 64;
+            }
+            if (carry == 0) {
+                Fr_rawCopy(r, t);
+                continue;
+            }
+            while (Fr_rawGeq(r, Fr_rawq)) Fr_rawSubNoMod(r, r, Fr_rawq);
+            exact = false;
         }
+        // r * scale mod q as a Montgomery product by scale in Montgomery form
+        FrRawElement rawScale = {scale, 0, 0, 0};
+        Fr_rawToMontgomery(aux, rawScale);
+        Fr_rawMMul(t, r, aux);
+        FrRawElement rawChunk = {chunk, 0, 0, 0};
+        Fr_rawAdd(r, t, rawChunk);
+    }
+    if (exact) {
+        // 2^256 < 6q
+        while (Fr_rawGeq(r, Fr_rawq)) Fr_rawSubNoMod(r, r, Fr_rawq);
+    }
+    return true;
+}
+
+// l[0..n) / d, returns the remainder and drops the top zero limbs.
+static inline __attribute__((always_inline)) uint32_t Fr_divLimbs(uint32_t *l, int &n, uint32_t d) {
+    uint64_t rem = 0;
+    for (int i=n-1; i>=0; i--) {
+        uint64_t cur = (rem << 32) | l[i];
+        l[i] = (uint32_t)(cur / d);
+        rem = cur % d;
+    }
+    while (n > 0 && l[n-1] == 0) n--;
+    return (uint32_t)rem;
+}
+
+// Inlined with constant arguments for base 10, so that the divisions become
+// multiplications.
+static inline __attribute__((always_inline)) size_t Fr_rawToDigitsBase(char *s, const FrRawElement a, uint base, uint32_t chunkPow, uint chunkDigits) {
+    static const char digitChars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    uint32_t l[2*Fr_N64];
+    for (int i=0; i<Fr_N64; i++) {
+        l[2*i] = (uint32_t)a[i];
+        l[2*i+1] = (uint32_t)(a[i] >> 32);
+    }
+    int n = 2*Fr_N64;
+    while (n > 0 && l[n-1] == 0) n--;
+
+    // digits are produced from the least significant one
+    char buf[Fr_N64*64];
+    char *p = buf + sizeof(buf);
+    while (n > 0) {
+        uint32_t rem = Fr_divLimbs(l, n, chunkPow);
+        for (uint k=0; k<chunkDigits && (n > 0 || rem != 0); k++) {
+            *--p = digitChars[rem % base];
+            rem /= base;
+        }
+    }
+    if (p == buf + sizeof(buf)) *--p = '0';
+    size_t len = buf + sizeof(buf) - p;
+    memcpy(s, p, len);
+    s[len] = 0;
+    return len;
+}
+
+size_t Fr_rawToDigits(char *s, const FrRawElement a, uint base) {
+    if (base == 10 || base < 2 || base > 36) {
+        return Fr_rawToDigitsBase(s, a, 10, 1000000000, 9);
+    }
+    uint chunkDigits = 0;
+    uint32_t chunkPow = 1;
+    while (chunkPow <= UINT32_MAX / base) {
+        chunkPow *= base;
+        chunkDigits++;
+    }
+    return Fr_rawToDigitsBase(s, a, base, chunkPow, chunkDigits);
+}
+
+void Fr_str2element(PFrElement pE, char const *s, uint base) {
+    bool negative = *s == '-';
+    if (negative) s++;
+    FrRawElement v;
+    if (!Fr_rawFromDigits(v, s, strlen(s), base)) {
+        v[0] = v[1] = v[2] = v[3] = 0;
+    }
+    if (negative) Fr_rawNeg(v, v);
+    if (v[1] == 0 && v[2] == 0 && v[3] == 0 && v[0] <= 0x7FFFFFFF) {
+        pE->type = Fr_SHORT;
+        pE->shortVal = (int32_t)v[0];
     } else {
-        Fr_toNormal(&tmp, pE);
-        mpz_init(r);
-        mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)tmp.longVal);
+        pE->type = Fr_LONG;
+        pE->shortVal = 0;
+        memcpy(pE->longVal, v, sizeof(FrRawElement));
     }
-    char *res = mpz_get_str (0, 10, r);
-    mpz_clear(r);
+}
+
+char *Fr_element2str(PFrElement pE) {
+    FrElement tmp;
+    Fr_toLongNormal(&tmp, pE);
+    char *res = new char[Fr_N64*64 + 1];
+    FrRawElement v;
+    memcpy(v, tmp.longVal, sizeof(FrRawElement));
+    Fr_rawToDigits(res, v, 10);
     return res;
 }
 
@@ -143,17 +275,216 @@ void Fr_pow(PFrElement r, PFrElement a, PFrElement b) {
     mpz_clear(mr);
 }
 
-void Fr_inv(PFrElement r, PFrElement a) {
-    mpz_t ma;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mr);
+/*
+Modular inversion with the safegcd algorithm of Bernstein and Yang, in the
+variable time form of libsecp256k1's modinv64: batches of 62 divsteps on
+the low limbs give a 2x2 transition matrix that is then applied to the
+full numbers in signed 62-bit limbs. No allocations and no GMP.
+*/
+
+#define FR_MASK62 (UINT64_MAX >> 2)
+
+struct FrSigned62 {
+    int64_t v[5];
+};
+
+struct FrTrans2x2 {
+    int64_t u, v, q, r;
+};
+
+static void Fr_toSigned62(FrSigned62 &r, const FrRawElement a) {
+    r.v[0] = a[0] & FR_MASK62;
+    r.v[1] = ((a[0] >> 62) | (a[1] << 2)) & FR_MASK62;
+    r.v[2] = ((a[1] >> 60) | (a[2] << 4)) & FR_MASK62;
+    r.v[3] = ((a[2] >> 58) | (a[3] << 6)) & FR_MASK62;
+    r.v[4] = a[3] >> 56;
+}
 
-    Fr_toMpz(ma, a);
-    mpz_invert(mr, ma, q);
-    Fr_fromMpz(r, mr);
-    mpz_clear(ma);
-    mpz_clear(mr);
+// a must be normalized to [0, q)
+static void Fr_fromSigned62(FrRawElement r, const FrSigned62 &a) {
+    r[0] = (uint64_t)a.v[0] | ((uint64_t)a.v[1] << 62);
+    r[1] = ((uint64_t)a.v[1] >> 2) | ((uint64_t)a.v[2] << 60);
+    r[2] = ((uint64_t)a.v[2] >> 4) | ((uint64_t)a.v[3] << 58);
+    r[3] = ((uint64_t)a.v[3] >> 6) | ((uint64_t)a.v[4] << 56);
+}
+
+struct FrModInfo {
+    FrSigned62 modulus;
+    uint64_t modulusInv62; // q^-1 mod 2^62
+    FrModInfo() {
+        Fr_toSigned62(modulus, Fr_rawq);
+        uint64_t inv = 1;
+        for (int i=0; i<6; i++) inv *= 2 - Fr_rawq[0]*inv;
+        modulusInv62 = inv & FR_MASK62;
+    }
+};
+
+static const FrModInfo &Fr_modInfo() {
+    static FrModInfo m;
+    return m;
+}
+
+// 62 divsteps on the low bits of f and g, eta = -delta.
+static int64_t Fr_divsteps62(int64_t eta, uint64_t f0, uint64_t g0, FrTrans2x2 &t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t f = f0, g = g0, m;
+    uint32_t w;
+    int i = 62, limit, zeros;
+    for (;;) {
+        zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+        g >>= zeros;
+        u <<= zeros;
+        v <<= zeros;
+        eta -= zeros;
+        i -= zeros;
+        if (i == 0) break;
+        if (eta < 0) {
+            uint64_t tmp;
+            eta = -eta;
+            tmp = f; f = g; g = -tmp;
+            tmp = u; u = q; q = -tmp;
+            tmp = v; v = r; r = -tmp;
+            // cancel up to 6 bits of g at once
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 63U;
+            w = (f * g * (f * f - 2)) & m;
+        } else {
+            // cancel up to 4 bits of g at once
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 15U;
+            w = f + (((f + 1) & 4) << 1);
+            w = (-w * g) & m;
+        }
+        g += f * w;
+        q += u * w;
+        r += v * w;
+    }
+    t.u = (int64_t)u;
+    t.v = (int64_t)v;
+    t.q = (int64_t)q;
+    t.r = (int64_t)r;
+    return eta;
+}
+
+// (d, e) = (t * (d, e)) / 2^62 mod q, keeping both in (-2q, q).
+static void Fr_updateDE62(FrSigned62 &d, FrSigned62 &e, const FrTrans2x2 &t, const FrModInfo &mi) {
+    const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+    int64_t sd = d.v[4] >> 63;
+    int64_t se = e.v[4] >> 63;
+    int64_t md = (u & sd) + (v & se);
+    int64_t me = (q & sd) + (r & se);
+    __int128 cd = (__int128)u * d.v[0] + (__int128)v * e.v[0];
+    __int128 ce = (__int128)q * d.v[0] + (__int128)r * e.v[0];
+    // choose md, me so that the low 62 bits become zero
+    md -= (mi.modulusInv62 * (uint64_t)cd + md) & FR_MASK62;
+    me -= (mi.modulusInv62 * (uint64_t)ce + me) & FR_MASK62;
+    cd += (__int128)mi.modulus.v[0] * md;
+    ce += (__int128)mi.modulus.v[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+    for (int i=1; i<5; i++) {
+        cd += (__int128)u * d.v[i] + (__int128)v * e.v[i] + (__int128)mi.modulus.v[i] * md;
+        ce += (__int128)q * d.v[i] + (__int128)r * e.v[i] + (__int128)mi.modulus.v[i] * me;
+        d.v[i-1] = (int64_t)cd & FR_MASK62;
+        e.v[i-1] = (int64_t)ce & FR_MASK62;
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d.v[4] = (int64_t)cd;
+    e.v[4] = (int64_t)ce;
+}
+
+// (f, g) = (t * (f, g)) / 2^62 on the len low limbs.
+static void Fr_updateFG62(int len, FrSigned62 &f, FrSigned62 &g, const FrTrans2x2 &t) {
+    const int64_t u = t.u, v = t.v, q = t.q, r = t.r;
+    __int128 cf = (__int128)u * f.v[0] + (__int128)v * g.v[0];
+    __int128 cg = (__int128)q * f.v[0] + (__int128)r * g.v[0];
+    cf >>= 62;
+    cg >>= 62;
+    for (int i=1; i<len; i++) {
+        cf += (__int128)u * f.v[i] + (__int128)v * g.v[i];
+        cg += (__int128)q * f.v[i] + (__int128)r * g.v[i];
+        f.v[i-1] = (int64_t)cf & FR_MASK62;
+        g.v[i-1] = (int64_t)cg & FR_MASK62;
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f.v[len-1] = (int64_t)cf;
+    g.v[len-1] = (int64_t)cg;
+}
+
+// Brings r from (-2q, q) to [0, q), negating it first if sign < 0.
+static void Fr_normalize62(FrSigned62 &r, int64_t sign, const FrModInfo &mi) {
+    int64_t condAdd = r.v[4] >> 63;
+    for (int i=0; i<5; i++) r.v[i] += mi.modulus.v[i] & condAdd;
+    int64_t condNegate = sign >> 63;
+    for (int i=0; i<5; i++) r.v[i] = (r.v[i] ^ condNegate) - condNegate;
+    for (int i=0; i<4; i++) {
+        r.v[i+1] += r.v[i] >> 62;
+        r.v[i] &= FR_MASK62;
+    }
+    condAdd = r.v[4] >> 63;
+    for (int i=0; i<5; i++) r.v[i] += mi.modulus.v[i] & condAdd;
+    for (int i=0; i<4; i++) {
+        r.v[i+1] += r.v[i] >> 62;
+        r.v[i] &= FR_MASK62;
+    }
+}
+
+// r = a^-1 mod q for a < q, and 0 for a = 0.
+void Fr_rawInv(FrRawElement r, const FrRawElement a) {
+    const FrModInfo &mi = Fr_modInfo();
+    FrSigned62 d = {{0, 0, 0, 0, 0}};
+    FrSigned62 e = {{1, 0, 0, 0, 0}};
+    FrSigned62 f = mi.modulus;
+    FrSigned62 g;
+    Fr_toSigned62(g, a);
+    int len = 5;
+    int64_t eta = -1;
+    for (;;) {
+        FrTrans2x2 t;
+        eta = Fr_divsteps62(eta, f.v[0], g.v[0], t);
+        Fr_updateDE62(d, e, t, mi);
+        Fr_updateFG62(len, f, g, t);
+        if (g.v[0] == 0) {
+            int64_t cond = 0;
+            for (int j=1; j<len; j++) cond |= g.v[j];
+            if (cond == 0) break;
+        }
+        // drop the top limb once both f and g fit in one less
+        int64_t fn = f.v[len-1];
+        int64_t gn = g.v[len-1];
+        int64_t cond = ((int64_t)len - 2) >> 63;
+        cond |= fn ^ (fn >> 63);
+        cond |= gn ^ (gn >> 63);
+        if (cond == 0) {
+            f.v[len-2] |= (uint64_t)fn << 62;
+            g.v[len-2] |= (uint64_t)gn << 62;
+            len--;
+        }
+    }
+    // f is now +-1 and d = +-a^-1
+    Fr_normalize62(d, f.v[len-1], mi);
+    Fr_fromSigned62(r, d);
+}
+
+// Montgomery inputs stay in Montgomery form: (aR)^-1 * R^3 / R = a^-1 R.
+void Fr_inv(PFrElement r, PFrElement a) {
+    FrRawElement v, t;
+    if (a->type & 0x40000000) { // Montgomery, long or short
+        memcpy(v, a->longVal, sizeof(FrRawElement));
+        Fr_rawInv(t, v);
+        Fr_rawMMul(v, t, Fr_rawR3);
+        r->type = Fr_LONGMONTGOMERY;
+    } else {
+        FrElement tmp;
+        Fr_toLongNormal(&tmp, a);
+        memcpy(t, tmp.longVal, sizeof(FrRawElement));
+        Fr_rawInv(v, t);
+        r->type = Fr_LONG;
+    }
+    memcpy(r->longVal, v, sizeof(FrRawElement));
+    r->shortVal = 0;
 }
 
 void Fr_div(PFrElement r, PFrElement a, PFrElement b) {
@@ -162,10 +493,250 @@ void Fr_div(PFrElement r, PFrElement a, PFrElement b) {
     Fr_mul(r, a, &tmp);
 }
 
+static void Fr_toRawMontgomery(FrRawElement r, PFrElement a) {
+    if (a->type == Fr_LONGMONTGOMERY) {
+        memcpy(r, a->longVal, sizeof(FrRawElement));
+    } else {
+        FrElement tmp;
+        Fr_toMontgomery(&tmp, a);
+        memcpy(r, tmp.longVal, sizeof(FrRawElement));
+    }
+}
+
+/*
+Montgomery's trick: out[i] holds the prefix products first, the product of
+all of them is inverted once and the inverses are peeled off backwards,
+3(n-1) multiplications in all. Zero entries are left out of the products
+and get 0, as Fr_inv gives.
+*/
+void Fr_batchInv(PFrElement out, PFrElement in, int n) {
+    FrRawElement a, acc, t, p;
+    int first = -1;
+    for (int i=0; i<n; i++) {
+        Fr_toRawMontgomery(a, &in[i]);
+        if (!Fr_rawIsZero(a)) {
+            if (first >= 0) {
+                Fr_rawMMul(t, acc, a);
+                Fr_rawCopy(acc, t);
+            } else {
+                Fr_rawCopy(acc, a);
+                first = i;
+            }
+        }
+        if (first >= 0) memcpy(out[i].longVal, acc, sizeof(FrRawElement));
+    }
+
+    FrRawElement inv;
+    if (first >= 0) {
+        Fr_rawInv(t, acc);
+        Fr_rawMMul(inv, t, Fr_rawR3);
+    }
+    for (int i=n-1; i>=0; i--) {
+        Fr_toRawMontgomery(a, &in[i]);
+        if (Fr_rawIsZero(a)) {
+            out[i].type = Fr_SHORT;
+            out[i].shortVal = 0;
+            continue;
+        }
+        if (i > first) {
+            memcpy(p, out[i-1].longVal, sizeof(FrRawElement));
+            Fr_rawMMul(t, inv, p);
+            Fr_rawMMul(acc, inv, a);
+            Fr_rawCopy(inv, acc);
+            memcpy(out[i].longVal, t, sizeof(FrRawElement));
+        } else {
+            memcpy(out[i].longVal, inv, sizeof(FrRawElement));
+        }
+        out[i].type = Fr_LONGMONTGOMERY;
+        out[i].shortVal = 0;
+    }
+}
+
+bool Fr_toBits(PFrElement out, PFrElement a, int n) {
+    FrRawElement v = {0, 0, 0, 0};
+    if (!(a->type & Fr_LONG) && a->shortVal >= 0) {
+        v[0] = (uint64_t)a->shortVal;
+    } else {
+        FrElement tmp;
+        Fr_toLongNormal(&tmp, a);
+        memcpy(v, tmp.longVal, sizeof(FrRawElement));
+    }
+    for (int i=0; i<n; i++) {
+        out[i].type = Fr_SHORT;
+        out[i].shortVal = i < Fr_N64*64 ? (v[i >> 6] >> (i & 63)) & 1 : 0;
+    }
+    for (int i=0; i<Fr_N64; i++) {
+        int low = n - i*64;
+        if (low >= 64) continue;
+        uint64_t high = low <= 0 ? v[i] : v[i] >> low;
+        if (high != 0) return false;
+    }
+    return true;
+}
+
 void Fr_fail() {
     assert(false);
 }
 
+/*
+Bulk conversions out of Montgomery form. With AVX-512 IFMA eight elements are
+reduced at once in radix 2^52: a 256-bit element is 5 limbs of 52 bits and
+a Montgomery reduction in that radix divides by 2^260, so the elements are
+shifted left by 4 bits first to get a / 2^256 mod q. Without IFMA the
+assembly Fr_rawFromMontgomery is used one element at a time.
+
+The arithmetic has no multi-lane versions: the generated templates compute
+one element at a time, with tagged short/long operands, so they cannot
+feed lanes without a batched code generator.
+*/
+
+#define FR_MASK52 0xFFFFFFFFFFFFFull
+
+struct FrIfmaConstants {
+    uint64_t q52[5];
+    uint64_t np52; // -q^-1 mod 2^52
+    bool available;
+    FrIfmaConstants() {
+        q52[0] = Fr_rawq[0] & FR_MASK52;
+        q52[1] = ((Fr_rawq[0] >> 52) | (Fr_rawq[1] << 12)) & FR_MASK52;
+        q52[2] = ((Fr_rawq[1] >> 40) | (Fr_rawq[2] << 24)) & FR_MASK52;
+        q52[3] = ((Fr_rawq[2] >> 28) | (Fr_rawq[3] << 36)) & FR_MASK52;
+        q52[4] = Fr_rawq[3] >> 16;
+        uint64_t inv = 1;
+        for (int i=0; i<6; i++) inv *= 2 - Fr_rawq[0]*inv;
+        np52 = (0 - inv) & FR_MASK52;
+        __builtin_cpu_init();
+        available = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+    }
+};
+
+static const FrIfmaConstants &Fr_ifma() {
+    static FrIfmaConstants c;
+    return c;
+}
+
+// r[i] = a[i] / R mod q for 8 elements, a[i] < q. r[i] may alias a[i] and
+// need not be aligned.
+__attribute__((target("avx512f,avx512ifma")))
+static void Fr_rawFromMontgomery_x8_ifma(uint8_t *r[8], const uint8_t *a[8]) {
+    const FrIfmaConstants &c = Fr_ifma();
+    __m512i mask = _mm512_set1_epi64(FR_MASK52);
+    __m512i zero = _mm512_setzero_si512();
+    FrRawElement in[8];
+    for (int k=0; k<8; k++) {
+        memcpy(in[k], a[k], sizeof(FrRawElement));
+    }
+    __m512i a64[4];
+    for (int j=0; j<4; j++) {
+        a64[j] = _mm512_set_epi64(in[7][j], in[6][j], in[5][j], in[4][j], in[3][j], in[2][j], in[1][j], in[0][j]);
+    }
+    // t = a * 2^4 in radix 2^52
+    __m512i t[6];
+    t[0] = _mm512_and_si512(_mm512_slli_epi64(a64[0], 4), mask);
+    t[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(a64[0], 48), _mm512_slli_epi64(a64[1], 16)), mask);
+    t[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(a64[1], 36), _mm512_slli_epi64(a64[2], 28)), mask);
+    t[3] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(a64[2], 24), _mm512_slli_epi64(a64[3], 40)), mask);
+    t[4] = _mm512_srli_epi64(a64[3], 12);
+    t[5] = zero;
+
+    __m512i q[5];
+    for (int j=0; j<5; j++) q[j] = _mm512_set1_epi64(c.q52[j]);
+    __m512i np = _mm512_set1_epi64(c.np52);
+
+    for (int i=0; i<5; i++) {
+        __m512i m = _mm512_and_si512(_mm512_madd52lo_epu64(zero, t[0], np), mask);
+        for (int j=0; j<5; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m, q[j]);
+            t[j+1] = _mm512_madd52hi_epu64(t[j+1], m, q[j]);
+        }
+        // t[0] is now a multiple of 2^52
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        for (int j=0; j<5; j++) t[j] = t[j+1];
+        t[5] = zero;
+    }
+    for (int j=0; j<4; j++) {
+        t[j+1] = _mm512_add_epi64(t[j+1], _mm512_srli_epi64(t[j], 52));
+        t[j] = _mm512_and_si512(t[j], mask);
+    }
+    // (a*2^4 + m*q) / 2^260 < q for a < q, so no final subtraction is needed
+
+    uint64_t out[4][8];
+    _mm512_storeu_si512(out[0], _mm512_or_si512(t[0], _mm512_slli_epi64(t[1], 52)));
+    _mm512_storeu_si512(out[1], _mm512_or_si512(_mm512_srli_epi64(t[1], 12), _mm512_slli_epi64(t[2], 40)));
+    _mm512_storeu_si512(out[2], _mm512_or_si512(_mm512_srli_epi64(t[2], 24), _mm512_slli_epi64(t[3], 28)));
+    _mm512_storeu_si512(out[3], _mm512_or_si512(_mm512_srli_epi64(t[3], 36), _mm512_slli_epi64(t[4], 16)));
+    for (int k=0; k<8; k++) {
+        uint64_t v[4] = {out[0][k], out[1][k], out[2][k], out[3][k]};
+        memcpy(r[k], v, sizeof(v));
+    }
+}
+
+// Converts a pending batch of at most 8 Montgomery elements.
+static void Fr_rawFromMontgomery_batch(uint8_t *r[8], const uint8_t *a[8], int n) {
+    if (n == 8 && Fr_ifma().available) {
+        Fr_rawFromMontgomery_x8_ifma(r, a);
+        return;
+    }
+    for (int k=0; k<n; k++) {
+        FrRawElement in, out;
+        memcpy(in, a[k], sizeof(in));
+        Fr_rawFromMontgomery(out, in);
+        memcpy(r[k], out, sizeof(out));
+    }
+}
+
+void Fr_rawFromMontgomery_n(FrRawElement *r, const FrRawElement *a, uint n) {
+    uint8_t *pr[8];
+    const uint8_t *pa[8];
+    int nPending = 0;
+    for (uint i=0; i<n; i++) {
+        pr[nPending] = (uint8_t *)r[i];
+        pa[nPending] = (const uint8_t *)a[i];
+        if (++nPending == 8) {
+            Fr_rawFromMontgomery_batch(pr, pa, nPending);
+            nPending = 0;
+        }
+    }
+    Fr_rawFromMontgomery_batch(pr, pa, nPending);
+}
+
+void Fr_toLongNormal_n(uint8_t *r, PFrElement a, const uint64_t *index, uint n) {
+    uint8_t *pr[8];
+    const uint8_t *pa[8];
+    int nPending = 0;
+    for (uint i=0; i<n; i++, r += Fr_N64*8) {
+        PFrElement e = index ? &a[index[i]] : &a[i];
+        if (e->type == Fr_LONGMONTGOMERY) {
+            pr[nPending] = r;
+            pa[nPending] = (const uint8_t *)e->longVal;
+            if (++nPending == 8) {
+                Fr_rawFromMontgomery_batch(pr, pa, nPending);
+                nPending = 0;
+            }
+        } else if (e->type & Fr_LONG) {
+            memcpy(r, e->longVal, Fr_N64*8);
+        } else {
+            FrElement tmp;
+            Fr_toLongNormal(&tmp, e);
+            memcpy(r, tmp.longVal, Fr_N64*8);
+        }
+    }
+    Fr_rawFromMontgomery_batch(pr, pa, nPending);
+}
+
+void Fr_toLongMontgomery_n(uint8_t *r, PFrElement a, const uint64_t *index, uint n) {
+    for (uint i=0; i<n; i++, r += Fr_N64*8) {
+        PFrElement e = index ? &a[index[i]] : &a[i];
+        if (e->type == Fr_LONGMONTGOMERY) {
+            memcpy(r, e->longVal, Fr_N64*8);
+        } else {
+            FrElement tmp;
+            Fr_toMontgomery(&tmp, e);
+            memcpy(r, tmp.longVal, Fr_N64*8);
+        }
+    }
+}
+
 
 RawFr::RawFr() {
     Fr_init();
@@ -178,13 +749,12 @@ RawFr::~RawFr() {
 }
 
 void RawFr::fromString(Element &r, const std::string &s, uint32_t radix) {
-    mpz_t mr;
-    mpz_init_set_str(mr, s.c_str(), radix);
-    mpz_fdiv_r(mr, mr, q);
-    for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
-    mpz_export((void *)(r.v), NULL, -1, 8, -1, 0, mr);
+    bool negative = !s.empty() && s[0] == '-';
+    if (!Fr_rawFromDigits(r.v, s.c_str() + negative, s.size() - negative, radix)) {
+        for (int i=0; i<Fr_N64; i++) r.v[i] = 0;
+    }
+    if (negative) Fr_rawNeg(r.v, r.v);
     Fr_rawToMontgomery(r.v,r.v);
-    mpz_clear(mr);
 }
 
 void RawFr::fromUI(Element &r, unsigned long int v) {
@@ -221,15 +791,10 @@ void RawFr::set(Element &r, int value) {
 
 std::string RawFr::toString(const Element &a, uint32_t radix) {
     Element tmp;
-    mpz_t r;
     Fr_rawFromMontgomery(tmp.v, a.v);
-    mpz_init(r);
-    mpz_import(r, Fr_N64, -1, 8, -1, 0, (const void *)(tmp.v));
-    char *res = mpz_get_str (0, radix, r);
-    mpz_clear(r);
-    std::string resS(res);
-    free(res);
-    return resS;
+    char res[Fr_N64*64 + 1];
+    size_t len = Fr_rawToDigits(res, tmp.v, radix);
+    return std::string(res, len);
 }
 
 void RawFr::inv(Element &r, const Element &a) {
@@ -69,15 +69,46 @@ extern "C" int Fr_rawIsZero(const FrRawElement pRawB);
 
 extern "C" void Fr_fail();
 
+// Field backend of the functions above: "asm" or "generic". The fastest
+// one the CPU supports is selected at startup, FR_BACKEND=<name> in the
+// environment overrides it. Fr_setBackend returns false if the backend is
+// not built in or not supported. The selection is not synchronized: switch
+// only while no other thread computes, e.g. before creating any context.
+bool Fr_setBackend(const char *name);
+const char *Fr_getBackend();
+
+
+// Bulk versions of Fr_rawFromMontgomery and Fr_toLongNormal, vectorized with
+// AVX-512 IFMA when the CPU has it. Fr_toLongNormal_n writes the 32-byte
+// long normal value of a[index[i]] (a[i] if index is NULL) at r + 32*i; r
+// need not be aligned.
+void Fr_rawFromMontgomery_n(FrRawElement *r, const FrRawElement *a, uint n);
+void Fr_toLongNormal_n(uint8_t *r, PFrElement a, const uint64_t *index, uint n);
+// Same as Fr_toLongNormal_n but writes the values in Montgomery form.
+void Fr_toLongMontgomery_n(uint8_t *r, PFrElement a, const uint64_t *index, uint n);
 
 // Pending functions to convert
 
 void Fr_str2element(PFrElement pE, char const*s, uint base);
 char *Fr_element2str(PFrElement pE);
+// Reads digits[0..n) in base 2 to 36 into r, reduced mod q. Returns false
+// on invalid digits or if there are none.
+bool Fr_rawFromDigits(FrRawElement r, const char *digits, size_t n, uint base);
+// Writes a, in normal form, in base 2 to 36 and a terminating 0 into s,
+// which needs room for 257 chars. Returns the number of digits.
+size_t Fr_rawToDigits(char *s, const FrRawElement a, uint base);
 void Fr_idiv(PFrElement r, PFrElement a, PFrElement b);
 void Fr_mod(PFrElement r, PFrElement a, PFrElement b);
+void Fr_rawInv(FrRawElement r, const FrRawElement a);
 void Fr_inv(PFrElement r, PFrElement a);
 void Fr_div(PFrElement r, PFrElement a, PFrElement b);
+// Inverts in[0..n-1] into out[0..n-1] with a single Fr_rawInv. Zeros give
+// 0 as in Fr_inv. out and in must not overlap.
+void Fr_batchInv(PFrElement out, PFrElement in, int n);
+// Writes the n low bits of a, in normal form, into out[0..n-1] as short 0/1
+// elements, least significant first. Returns whether they add back up to a,
+// that is whether a < 2^n. a must not be one of the outputs.
+bool Fr_toBits(PFrElement out, PFrElement a, int n);
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b);
 
 class RawFr {
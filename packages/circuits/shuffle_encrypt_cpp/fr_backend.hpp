@@ -0,0 +1,64 @@
+#ifndef __FR_BACKEND_H
+#define __FR_BACKEND_H
+
+#include "fr.hpp"
+
+/*
+Field backends. Every backend implements the functions below with the
+signatures of fr.hpp; fr_dispatch.cpp defines the Fr_* symbols themselves
+and forwards them to the backend selected at startup.
+fr.asm exports Fr_rawMMul1 for this, the generated code only uses it
+internally.
+
+  asm      fr.asm, assembled with an asm_ symbol prefix. Needs BMI2 and ADX.
+  generic  fr_generic.cpp, portable C++ in the FrGeneric namespace.
+*/
+
+#define FR_BACKEND_FUNCTIONS(X) \
+    X(void, Fr_copy, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_copyn, (PFrElement r, PFrElement a, int n), (r, a, n)) \
+    X(void, Fr_add, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_sub, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_neg, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_mul, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_square, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_band, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_bor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_bxor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_bnot, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_shl, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_shr, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_eq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_neq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_lt, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_gt, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_leq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_geq, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_land, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_lor, (PFrElement r, PFrElement a, PFrElement b), (r, a, b)) \
+    X(void, Fr_lnot, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_toNormal, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_toLongNormal, (PFrElement r, PFrElement a), (r, a)) \
+    X(void, Fr_toMontgomery, (PFrElement r, PFrElement a), (r, a)) \
+    X(int, Fr_isTrue, (PFrElement pE), (pE)) \
+    X(int, Fr_toInt, (PFrElement pE), (pE)) \
+    X(void, Fr_rawCopy, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, Fr_rawSwap, (FrRawElement pRawResult, FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, Fr_rawAdd, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, Fr_rawSub, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, Fr_rawNeg, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, Fr_rawMMul, (FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, Fr_rawMSquare, (FrRawElement pRawResult, const FrRawElement pRawA), (pRawResult, pRawA)) \
+    X(void, Fr_rawMMul1, (FrRawElement pRawResult, const FrRawElement pRawA, uint64_t pRawB), (pRawResult, pRawA, pRawB)) \
+    X(void, Fr_rawToMontgomery, (FrRawElement pRawResult, const FrRawElement &pRawA), (pRawResult, pRawA)) \
+    X(void, Fr_rawFromMontgomery, (FrRawElement pRawResult, const FrRawElement &pRawA), (pRawResult, pRawA)) \
+    X(int, Fr_rawIsEq, (const FrRawElement pRawA, const FrRawElement pRawB), (pRawA, pRawB)) \
+    X(int, Fr_rawIsZero, (const FrRawElement pRawB), (pRawB))
+
+#define FR_DECLARE_BACKEND_FUNCTION(ret, name, params, args) ret name params;
+
+namespace FrGeneric {
+FR_BACKEND_FUNCTIONS(FR_DECLARE_BACKEND_FUNCTION)
+}
+
+#endif // __FR_BACKEND_H
@@ -0,0 +1,85 @@
+#include "fr_backend.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cpuid.h>
+
+FrElement Fr_q = {0, Fr_LONG, {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029}};
+FrElement Fr_R3 = {0, Fr_LONG, {0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c}};
+FrRawElement Fr_rawq = {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029};
+FrRawElement Fr_rawR3 = {0x5e94d8e1b4bf0040,0x2a489cbe1cfbb6b8,0x893cc664a19fcfed,0x0cf8594b7fcc657c};
+
+struct FrBackend {
+    const char *name;
+#define FR_BACKEND_MEMBER(ret, name, params, args) ret (*name) params;
+    FR_BACKEND_FUNCTIONS(FR_BACKEND_MEMBER)
+};
+
+#define FR_GENERIC_ENTRY(ret, name, params, args) FrGeneric::name,
+
+static const FrBackend Fr_genericBackend = {"generic", FR_BACKEND_FUNCTIONS(FR_GENERIC_ENTRY)};
+
+#ifndef FR_NO_ASM
+#define FR_DECLARE_ASM_FUNCTION(ret, name, params, args) extern "C" ret asm_##name params;
+FR_BACKEND_FUNCTIONS(FR_DECLARE_ASM_FUNCTION)
+
+#define FR_ASM_ENTRY(ret, name, params, args) asm_##name,
+
+static const FrBackend Fr_asmBackend = {"asm", FR_BACKEND_FUNCTIONS(FR_ASM_ENTRY)};
+
+// fr.asm calls back into C for failures
+extern "C" void asm_Fr_fail() {
+    Fr_fail();
+}
+
+static bool Fr_asmSupported() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    bool bmi2 = ebx & (1 << 8);
+    bool adx = ebx & (1 << 19);
+    return bmi2 && adx;
+}
+#endif // FR_NO_ASM
+
+// The backend's functions, copied from one of the tables above by
+// Fr_setBackend, so that a call costs one indirect call and no
+// synchronization. Starts on the generic backend, which runs everywhere, so
+// that calls made by other static initializers work before the selection
+// below.
+static FrBackend Fr_backend = {"generic", FR_BACKEND_FUNCTIONS(FR_GENERIC_ENTRY)};
+
+#define FR_FORWARD(ret, name, params, args) extern "C" ret name params { return Fr_backend.name args; }
+FR_BACKEND_FUNCTIONS(FR_FORWARD)
+
+bool Fr_setBackend(const char *name) {
+#ifndef FR_NO_ASM
+    if (strcmp(name, Fr_asmBackend.name) == 0) {
+        if (!Fr_asmSupported()) return false;
+        Fr_backend = Fr_asmBackend;
+        return true;
+    }
+#endif
+    if (strcmp(name, Fr_genericBackend.name) == 0) {
+        Fr_backend = Fr_genericBackend;
+        return true;
+    }
+    return false;
+}
+
+const char *Fr_getBackend() {
+    return Fr_backend.name;
+}
+
+static bool Fr_selectBackend() {
+    const char *name = getenv("FR_BACKEND");
+    if (name != NULL && *name != '\0') {
+        if (Fr_setBackend(name)) return true;
+        fprintf(stderr, "Field backend %s is not available, using the default one\n", name);
+    }
+#ifndef FR_NO_ASM
+    if (Fr_setBackend(Fr_asmBackend.name)) return true;
+#endif
+    return Fr_setBackend(Fr_genericBackend.name);
+}
+
+static bool backendSelected = Fr_selectBackend();
@@ -0,0 +1,554 @@
+#include "fr_backend.hpp"
+#include <string.h>
+
+/*
+Portable implementation of the fr.hpp functions, the generic backend of
+fr_dispatch.cpp. Same element representation and Montgomery constant
+R = 2^256 as fr.asm, so elements can be passed between the backends.
+*/
+
+namespace FrGeneric {
+
+typedef unsigned __int128 u128;
+
+#define Fr_N64_MASK_HI 0x3fffffffffffffffULL
+#define Fr_NP 0xc2e1f593efffffffULL
+
+static const FrRawElement rawQ    = {0x43e1f593f0000001,0x2833e84879b97091,0xb85045b68181585d,0x30644e72e131a029};
+static const FrRawElement rawHalf = {0xa1f0fac9f8000000,0x9419f4243cdcb848,0xdc2822db40c0ac2e,0x183227397098d014};
+static const FrRawElement rawR2   = {0x1bb8e645ae216da7,0x53fe3ab1e35c59e3,0x8c49833d53bb8085,0x0216d0b17f4e44a5};
+
+// raw helpers
+
+static inline int rawCmp(const uint64_t *a, const uint64_t *b) {
+    for (int i = Fr_N64-1; i >= 0; i--) {
+        if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+static inline uint64_t rawSubNoMod(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t borrow = 0;
+    for (int i = 0; i < Fr_N64; i++) {
+        u128 d = (u128)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow;
+}
+
+static inline uint64_t rawAddNoMod(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t carry = 0;
+    for (int i = 0; i < Fr_N64; i++) {
+        u128 s = (u128)a[i] + b[i] + carry;
+        r[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    return carry;
+}
+
+static inline void rawReduceOnce(uint64_t *r) {
+    if (rawCmp(r, rawQ) >= 0) rawSubNoMod(r, r, rawQ);
+}
+
+void Fr_rawCopy(FrRawElement pRawResult, const FrRawElement pRawA) {
+    memcpy(pRawResult, pRawA, sizeof(FrRawElement));
+}
+
+void Fr_rawZero(FrRawElement pRawResult) {
+    memset(pRawResult, 0, sizeof(FrRawElement));
+}
+
+void Fr_rawSwap(FrRawElement pRawResult, FrRawElement pRawA) {
+    FrRawElement tmp;
+    memcpy(tmp, pRawResult, sizeof(FrRawElement));
+    memcpy(pRawResult, pRawA, sizeof(FrRawElement));
+    memcpy(pRawA, tmp, sizeof(FrRawElement));
+}
+
+void Fr_rawAdd(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    // q < 2^254, so the sum of two reduced elements never carries out of 4 limbs
+    rawAddNoMod(pRawResult, pRawA, pRawB);
+    rawReduceOnce(pRawResult);
+}
+
+void Fr_rawSub(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    if (rawSubNoMod(pRawResult, pRawA, pRawB)) rawAddNoMod(pRawResult, pRawResult, rawQ);
+}
+
+void Fr_rawNeg(FrRawElement pRawResult, const FrRawElement pRawA) {
+    if (Fr_rawIsZero(pRawA)) {
+        Fr_rawZero(pRawResult);
+    } else {
+        rawSubNoMod(pRawResult, rawQ, pRawA);
+    }
+}
+
+void Fr_rawMMul(FrRawElement pRawResult, const FrRawElement pRawA, const FrRawElement pRawB) {
+    // CIOS Montgomery multiplication
+    uint64_t t[Fr_N64+2] = {0};
+    for (int i = 0; i < Fr_N64; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < Fr_N64; j++) {
+            u128 p = (u128)pRawA[j] * pRawB[i] + t[j] + carry;
+            t[j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        u128 s = (u128)t[Fr_N64] + carry;
+        t[Fr_N64] = (uint64_t)s;
+        t[Fr_N64+1] = (uint64_t)(s >> 64);
+
+        uint64_t m = t[0] * Fr_NP;
+        u128 p = (u128)m * rawQ[0] + t[0];
+        carry = (uint64_t)(p >> 64);
+        for (int j = 1; j < Fr_N64; j++) {
+            p = (u128)m * rawQ[j] + t[j] + carry;
+            t[j-1] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        s = (u128)t[Fr_N64] + carry;
+        t[Fr_N64-1] = (uint64_t)s;
+        t[Fr_N64] = t[Fr_N64+1] + (uint64_t)(s >> 64);
+    }
+    memcpy(pRawResult, t, sizeof(FrRawElement));
+    rawReduceOnce(pRawResult);
+}
+
+void Fr_rawMSquare(FrRawElement pRawResult, const FrRawElement pRawA) {
+    Fr_rawMMul(pRawResult, pRawA, pRawA);
+}
+
+void Fr_rawMMul1(FrRawElement pRawResult, const FrRawElement pRawA, uint64_t pRawB) {
+    FrRawElement b = {pRawB, 0, 0, 0};
+    Fr_rawMMul(pRawResult, pRawA, b);
+}
+
+void Fr_rawToMontgomery(FrRawElement pRawResult, const FrRawElement &pRawA) {
+    Fr_rawMMul(pRawResult, pRawA, rawR2);
+}
+
+void Fr_rawFromMontgomery(FrRawElement pRawResult, const FrRawElement &pRawA) {
+    // the reduction steps of Fr_rawMMul(a, 1) alone: the product by one is a
+    uint64_t t[Fr_N64];
+    memcpy(t, pRawA, sizeof(t));
+    for (int i = 0; i < Fr_N64; i++) {
+        uint64_t m = t[0] * Fr_NP;
+        u128 p = (u128)m * rawQ[0] + t[0];
+        uint64_t carry = (uint64_t)(p >> 64);
+        for (int j = 1; j < Fr_N64; j++) {
+            p = (u128)m * rawQ[j] + t[j] + carry;
+            t[j-1] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        t[Fr_N64-1] = carry;
+    }
+    memcpy(pRawResult, t, sizeof(t));
+    rawReduceOnce(pRawResult);
+}
+
+int Fr_rawIsEq(const FrRawElement pRawA, const FrRawElement pRawB) {
+    return rawCmp(pRawA, pRawB) == 0;
+}
+
+int Fr_rawIsZero(const FrRawElement pRawB) {
+    return (pRawB[0] | pRawB[1] | pRawB[2] | pRawB[3]) == 0;
+}
+
+// element helpers
+
+static inline bool isShort(PFrElement a) { return !(a->type & Fr_LONG); }
+static inline bool isMontgomery(PFrElement a) { return (a->type & Fr_LONGMONTGOMERY) == Fr_LONGMONTGOMERY; }
+
+static inline void setShort(PFrElement r, int32_t v) {
+    r->shortVal = v;
+    r->type = Fr_SHORT;
+}
+
+// Stores a 64 bit signed integer as a short element if it fits, long normal otherwise.
+static inline void setInt64(PFrElement r, int64_t v) {
+    if (v >= INT32_MIN && v <= INT32_MAX) {
+        setShort(r, (int32_t)v);
+        return;
+    }
+    r->shortVal = 0;
+    r->type = Fr_LONG;
+    if (v >= 0) {
+        r->longVal[0] = (uint64_t)v;
+        r->longVal[1] = r->longVal[2] = r->longVal[3] = 0;
+    } else {
+        FrRawElement a = {(uint64_t)(-(v+1)) + 1, 0, 0, 0};
+        FrRawElement n;
+        rawSubNoMod(n, rawQ, a);
+        memcpy(r->longVal, n, sizeof(FrRawElement));
+    }
+}
+
+// longVal is not aligned in the packed FrElement, the raw functions get a
+// copy of it.
+static inline void getLong(FrRawElement r, PFrElement a) {
+    memcpy(r, a->longVal, sizeof(FrRawElement));
+}
+
+static inline void toRawNormal(FrRawElement r, PFrElement a) {
+    if (isShort(a)) {
+        if (a->shortVal >= 0) {
+            r[0] = (uint64_t)a->shortVal;
+            r[1] = r[2] = r[3] = 0;
+        } else {
+            FrRawElement v = {(uint64_t)(-(int64_t)a->shortVal), 0, 0, 0};
+            rawSubNoMod(r, rawQ, v);
+        }
+    } else if (isMontgomery(a)) {
+        FrRawElement v;
+        getLong(v, a);
+        Fr_rawFromMontgomery(r, v);
+    } else {
+        getLong(r, a);
+    }
+}
+
+static inline void toRawMontgomery(FrRawElement r, PFrElement a) {
+    if (isMontgomery(a)) {
+        getLong(r, a);
+    } else {
+        FrRawElement n;
+        toRawNormal(n, a);
+        Fr_rawToMontgomery(r, n);
+    }
+}
+
+static inline void setLong(PFrElement r, const FrRawElement v, uint32_t type) {
+    r->shortVal = 0;
+    r->type = type;
+    memcpy(r->longVal, v, sizeof(FrRawElement));
+}
+
+// Signed view used by the comparison operators: elements above (q-1)/2 are negative.
+static inline int signedCmp(PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b)) {
+        return a->shortVal < b->shortVal ? -1 : (a->shortVal > b->shortVal ? 1 : 0);
+    }
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    bool na = rawCmp(ra, rawHalf) > 0;
+    bool nb = rawCmp(rb, rawHalf) > 0;
+    if (na != nb) return na ? -1 : 1;
+    return rawCmp(ra, rb);
+}
+
+static inline bool isEqual(PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b)) return a->shortVal == b->shortVal;
+    FrRawElement ra, rb;
+    if (isMontgomery(a) && isMontgomery(b)) {
+        getLong(ra, a);
+        getLong(rb, b);
+    } else {
+        toRawNormal(ra, a);
+        toRawNormal(rb, b);
+    }
+    return Fr_rawIsEq(ra, rb);
+}
+
+// Masks to 254 bits and reduces, as the bitwise operators do.
+static inline void maskReduce(uint64_t *r) {
+    r[3] &= Fr_N64_MASK_HI;
+    rawReduceOnce(r);
+}
+
+// element operations
+
+void Fr_copy(PFrElement r, PFrElement a) {
+    *r = *a;
+}
+
+void Fr_copyn(PFrElement r, PFrElement a, int n) {
+    memmove(r, a, (size_t)n * sizeof(FrElement));
+}
+
+void Fr_toNormal(PFrElement r, PFrElement a) {
+    if (isMontgomery(a)) {
+        FrRawElement v;
+        Fr_rawFromMontgomery(v, a->longVal);
+        setLong(r, v, Fr_LONG);
+    } else {
+        *r = *a;
+    }
+}
+
+void Fr_toLongNormal(PFrElement r, PFrElement a) {
+    FrRawElement v;
+    toRawNormal(v, a);
+    setLong(r, v, Fr_LONG);
+}
+
+void Fr_toMontgomery(PFrElement r, PFrElement a) {
+    FrRawElement v;
+    toRawMontgomery(v, a);
+    setLong(r, v, Fr_LONGMONTGOMERY);
+}
+
+void Fr_add(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b)) {
+        setInt64(r, (int64_t)a->shortVal + b->shortVal);
+    } else if (isMontgomery(a) || isMontgomery(b)) {
+        FrRawElement ra, rb;
+        toRawMontgomery(ra, a);
+        toRawMontgomery(rb, b);
+        Fr_rawAdd(ra, ra, rb);
+        setLong(r, ra, Fr_LONGMONTGOMERY);
+    } else {
+        FrRawElement ra, rb;
+        toRawNormal(ra, a);
+        toRawNormal(rb, b);
+        Fr_rawAdd(ra, ra, rb);
+        setLong(r, ra, Fr_LONG);
+    }
+}
+
+void Fr_sub(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b)) {
+        setInt64(r, (int64_t)a->shortVal - b->shortVal);
+    } else if (isMontgomery(a) || isMontgomery(b)) {
+        FrRawElement ra, rb;
+        toRawMontgomery(ra, a);
+        toRawMontgomery(rb, b);
+        Fr_rawSub(ra, ra, rb);
+        setLong(r, ra, Fr_LONGMONTGOMERY);
+    } else {
+        FrRawElement ra, rb;
+        toRawNormal(ra, a);
+        toRawNormal(rb, b);
+        Fr_rawSub(ra, ra, rb);
+        setLong(r, ra, Fr_LONG);
+    }
+}
+
+void Fr_neg(PFrElement r, PFrElement a) {
+    if (isShort(a)) {
+        setInt64(r, -(int64_t)a->shortVal);
+    } else {
+        FrRawElement v, n;
+        getLong(n, a);
+        Fr_rawNeg(v, n);
+        setLong(r, v, a->type);
+    }
+}
+
+void Fr_mul(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b)) {
+        setInt64(r, (int64_t)a->shortVal * b->shortVal);
+        return;
+    }
+    FrRawElement v;
+    if (isMontgomery(a) && isMontgomery(b)) {
+        FrRawElement ra, rb;
+        getLong(ra, a);
+        getLong(rb, b);
+        Fr_rawMMul(v, ra, rb);
+        setLong(r, v, Fr_LONGMONTGOMERY);
+    } else if (isMontgomery(a) || isMontgomery(b)) {
+        // (xR * y) R^-1 = xy, already in normal form
+        PFrElement m = isMontgomery(a) ? a : b;
+        PFrElement n = isMontgomery(a) ? b : a;
+        FrRawElement rm, rn;
+        getLong(rm, m);
+        toRawNormal(rn, n);
+        Fr_rawMMul(v, rm, rn);
+        setLong(r, v, Fr_LONG);
+    } else {
+        // (x * y) R^-1 * R^3 R^-1 = xyR
+        FrRawElement ra, rb;
+        toRawNormal(ra, a);
+        toRawNormal(rb, b);
+        Fr_rawMMul(v, ra, rb);
+        Fr_rawMMul(v, v, ::Fr_rawR3);
+        setLong(r, v, Fr_LONGMONTGOMERY);
+    }
+}
+
+void Fr_square(PFrElement r, PFrElement a) {
+    FrGeneric::Fr_mul(r, a, a);
+}
+
+void Fr_band(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal & b->shortVal);
+        return;
+    }
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    for (int i = 0; i < Fr_N64; i++) ra[i] &= rb[i];
+    maskReduce(ra);
+    setLong(r, ra, Fr_LONG);
+}
+
+void Fr_bor(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal | b->shortVal);
+        return;
+    }
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    for (int i = 0; i < Fr_N64; i++) ra[i] |= rb[i];
+    maskReduce(ra);
+    setLong(r, ra, Fr_LONG);
+}
+
+void Fr_bxor(PFrElement r, PFrElement a, PFrElement b) {
+    if (isShort(a) && isShort(b) && a->shortVal >= 0 && b->shortVal >= 0) {
+        setShort(r, a->shortVal ^ b->shortVal);
+        return;
+    }
+    FrRawElement ra, rb;
+    toRawNormal(ra, a);
+    toRawNormal(rb, b);
+    for (int i = 0; i < Fr_N64; i++) ra[i] ^= rb[i];
+    maskReduce(ra);
+    setLong(r, ra, Fr_LONG);
+}
+
+void Fr_bnot(PFrElement r, PFrElement a) {
+    FrRawElement ra;
+    toRawNormal(ra, a);
+    for (int i = 0; i < Fr_N64; i++) ra[i] = ~ra[i];
+    maskReduce(ra);
+    setLong(r, ra, Fr_LONG);
+}
+
+static void rawShr(FrRawElement r, const FrRawElement a, unsigned n) {
+    unsigned limbs = n / 64, bits = n % 64;
+    for (unsigned i = 0; i < Fr_N64; i++) {
+        uint64_t lo = (i + limbs < Fr_N64) ? a[i + limbs] : 0;
+        uint64_t hi = (i + limbs + 1 < Fr_N64) ? a[i + limbs + 1] : 0;
+        r[i] = bits ? ((lo >> bits) | (hi << (64 - bits))) : lo;
+    }
+}
+
+static void rawShl(FrRawElement r, const FrRawElement a, unsigned n) {
+    unsigned limbs = n / 64, bits = n % 64;
+    for (int i = Fr_N64-1; i >= 0; i--) {
+        uint64_t hi = (i >= (int)limbs) ? a[i - limbs] : 0;
+        uint64_t lo = (i >= (int)limbs + 1) ? a[i - limbs - 1] : 0;
+        r[i] = bits ? ((hi << bits) | (lo >> (64 - bits))) : hi;
+    }
+    maskReduce(r);
+}
+
+// Decodes a shift amount: returns false when the result is zero, otherwise the
+// amount and whether the direction is reversed (negative shifts).
+static bool shiftAmount(PFrElement b, unsigned &n, bool &reverse) {
+    if (isShort(b)) {
+        int64_t v = b->shortVal;
+        reverse = v < 0;
+        if (reverse) v = -v;
+        if (v >= 254) return false;
+        n = (unsigned)v;
+        return true;
+    }
+    FrRawElement rb;
+    toRawNormal(rb, b);
+    if (rb[1] == 0 && rb[2] == 0 && rb[3] == 0 && rb[0] < 254) {
+        n = (unsigned)rb[0];
+        reverse = false;
+        return true;
+    }
+    FrRawElement nb;
+    rawSubNoMod(nb, rawQ, rb);
+    if (nb[1] == 0 && nb[2] == 0 && nb[3] == 0 && nb[0] < 254) {
+        n = (unsigned)nb[0];
+        reverse = true;
+        return true;
+    }
+    return false;
+}
+
+static void doShift(PFrElement r, PFrElement a, PFrElement b, bool left) {
+    unsigned n;
+    bool reverse;
+    if (!shiftAmount(b, n, reverse)) {
+        setShort(r, 0);
+        return;
+    }
+    if (reverse) left = !left;
+    if (!left && isShort(a) && a->shortVal >= 0) {
+        setShort(r, n >= 31 ? 0 : a->shortVal >> n);
+        return;
+    }
+    FrRawElement ra, v;
+    toRawNormal(ra, a);
+    if (left) rawShl(v, ra, n);
+    else rawShr(v, ra, n);
+    setLong(r, v, Fr_LONG);
+}
+
+void Fr_shr(PFrElement r, PFrElement a, PFrElement b) {
+    doShift(r, a, b, false);
+}
+
+void Fr_shl(PFrElement r, PFrElement a, PFrElement b) {
+    doShift(r, a, b, true);
+}
+
+void Fr_eq(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, isEqual(a, b));
+}
+
+void Fr_neq(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, !isEqual(a, b));
+}
+
+void Fr_lt(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, signedCmp(a, b) < 0);
+}
+
+void Fr_gt(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, signedCmp(a, b) > 0);
+}
+
+void Fr_leq(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, signedCmp(a, b) <= 0);
+}
+
+void Fr_geq(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, signedCmp(a, b) >= 0);
+}
+
+int Fr_isTrue(PFrElement pE) {
+    if (isShort(pE)) return pE->shortVal != 0;
+    FrRawElement v;
+    getLong(v, pE);
+    return !Fr_rawIsZero(v);
+}
+
+void Fr_land(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, FrGeneric::Fr_isTrue(a) && FrGeneric::Fr_isTrue(b));
+}
+
+void Fr_lor(PFrElement r, PFrElement a, PFrElement b) {
+    setShort(r, FrGeneric::Fr_isTrue(a) || FrGeneric::Fr_isTrue(b));
+}
+
+void Fr_lnot(PFrElement r, PFrElement a) {
+    setShort(r, !FrGeneric::Fr_isTrue(a));
+}
+
+int Fr_toInt(PFrElement pE) {
+    if (isShort(pE)) return pE->shortVal;
+    FrRawElement v;
+    toRawNormal(v, pE);
+    if (v[1] == 0 && v[2] == 0 && v[3] == 0 && v[0] <= INT32_MAX) {
+        return (int)v[0];
+    }
+    FrRawElement n;
+    rawSubNoMod(n, rawQ, v);
+    if (n[1] == 0 && n[2] == 0 && n[3] == 0 && n[0] <= ((uint64_t)1 << 31)) {
+        return (int)(-(int64_t)n[0]);
+    }
+    Fr_fail();
+    return 0;
+}
+
+} // namespace FrGeneric
@@ -1,268 +1,221 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <iomanip>
-#include <sys/stat.h>
-#include <sys/mman.h>
-#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <unistd.h>
-#include <nlohmann/json.hpp>
+#include <string.h>
+#include <assert.h>
 #include <vector>
 #include <chrono>
+#include <thread>
+#include <atomic>
 
-using json = nlohmann::json;
-
-#include "calcwit.hpp"
-#include "circom.hpp"
+#include "witness.hpp"
 
 
 #define handle_error(msg) \
            do { perror(msg); exit(EXIT_FAILURE); } while (0)
 
-Circom_Circuit* loadCircuit(std::string const &datFileName) {
-    Circom_Circuit *circuit = new Circom_Circuit;
+/*
+Server mode: the circuit is loaded once and every worker thread keeps a warm
+Circom_CalcWit that is reset between requests. A client sends any number of
+requests on a connection, each one
 
-    int fd;
-    struct stat sb;
+  u64 length | <length> bytes of input JSON or binary input
 
-    fd = open(datFileName.c_str(), O_RDONLY);
-    if (fd == -1) {
-        std::cout << ".dat file not found: " << datFileName << "\n";
-        throw std::system_error(errno, std::generic_category(), "open");
-    }
-    
-    if (fstat(fd, &sb) == -1) {          /* To obtain file size */
-        throw std::system_error(errno, std::generic_category(), "fstat");
-    }
+and gets back for each of them
 
-    u8* bdata = (u8*)mmap(NULL, sb.st_size, PROT_READ , MAP_PRIVATE, fd, 0);
-    close(fd);
+  u32 status | u64 length | <length> bytes
 
-    circuit->InputHashMap = new HashSignalInfo[get_size_of_input_hashmap()];
-    uint dsize = get_size_of_input_hashmap()*sizeof(HashSignalInfo);
-    memcpy((void *)(circuit->InputHashMap), (void *)bdata, dsize);
+where status 0 means the bytes are the .wtns file and 1 means they are an
+error message, as for inputs with unknown or repeated signals, after which
+the connection takes the next request. All integers are little endian.
+Failed circuit asserts still abort the process as in the command line mode.
+*/
 
-    circuit->witness2SignalList = new u64[get_size_of_witness()];
-    uint inisize = dsize;    
-    dsize = get_size_of_witness()*sizeof(u64);
-    memcpy((void *)(circuit->witness2SignalList), (void *)(bdata+inisize), dsize);
-
-    circuit->circuitConstants = new FrElement[get_size_of_constants()];
-    if (get_size_of_constants()>0) {
-      inisize += dsize;
-      dsize = get_size_of_constants()*sizeof(FrElement);
-      memcpy((void *)(circuit->circuitConstants), (void *)(bdata+inisize), dsize);
-    }
+#define MAX_REQUEST_SIZE (64 << 20)
 
-    std::map<u32,IODefPair> templateInsId2IOSignalInfo1;
-    if (get_size_of_io_map()>0) {
-      u32 index[get_size_of_io_map()];
-      inisize += dsize;
-      dsize = get_size_of_io_map()*sizeof(u32);
-      memcpy((void *)index, (void *)(bdata+inisize), dsize);
-      inisize += dsize;
-      assert(inisize % sizeof(u32) == 0);    
-      assert(sb.st_size % sizeof(u32) == 0);
-      u32 dataiomap[(sb.st_size-inisize)/sizeof(u32)];
-      memcpy((void *)dataiomap, (void *)(bdata+inisize), sb.st_size-inisize);
-      u32* pu32 = dataiomap;
+static bool readFull(int fd, void *buf, size_t n) {
+  u8 *p = (u8 *)buf;
+  while (n > 0) {
+    ssize_t r = read(fd, p, n);
+    if (r == -1 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    p += r;
+    n -= r;
+  }
+  return true;
+}
 
-      for (int i = 0; i < get_size_of_io_map(); i++) {
-	u32 n = *pu32;
-	IODefPair p;
-	p.len = n;
-	IODef defs[n];
-	pu32 += 1;
-	for (u32 j = 0; j <n; j++){
-	  defs[j].offset=*pu32;
-	  u32 len = *(pu32+1);
-	  defs[j].len = len;
-	  defs[j].lengths = new u32[len];
-	  memcpy((void *)defs[j].lengths,(void *)(pu32+2),len*sizeof(u32));
-	  pu32 += len + 2;
-	}
-	p.defs = (IODef*)calloc(10, sizeof(IODef));
-	for (u32 j = 0; j < p.len; j++){
-	  p.defs[j] = defs[j];
-	}
-	templateInsId2IOSignalInfo1[index[i]] = p;
-      }
-    }
-    circuit->templateInsId2IOSignalInfo = move(templateInsId2IOSignalInfo1);
-    
-    munmap(bdata, sb.st_size);
-    
-    return circuit;
+static bool writeFull(int fd, const void *buf, size_t n) {
+  const u8 *p = (const u8 *)buf;
+  while (n > 0) {
+    ssize_t r = send(fd, p, n, MSG_NOSIGNAL);
+    if (r == -1 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    p += r;
+    n -= r;
+  }
+  return true;
 }
 
-bool check_valid_number(std::string & s, uint base){
-  bool is_valid = true;
-  if (base == 16){
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= (
-        ('0' <= s[i] && s[i] <= '9') || 
-        ('a' <= s[i] && s[i] <= 'f') ||
-        ('A' <= s[i] && s[i] <= 'F')
-      );
-    }
-  } else{
-    for (uint i = 0; i < s.size(); i++){
-      is_valid &= ('0' <= s[i] && s[i] < char(int('0') + base));
+static void serveConnection(Circom_CalcWit *ctx, int conn) {
+  u64 len;
+  while (readFull(conn, &len, sizeof(len))) {
+    if (len > MAX_REQUEST_SIZE) return;
+    std::string input(len, '\0');
+    if (!readFull(conn, &input[0], len)) return;
+    u32 status = 0;
+    std::string response;
+    try {
+      calcWitness(ctx, input, response);
+    } catch (std::exception &e) {
+      status = 1;
+      response = e.what();
     }
+    u64 responseLen = response.size();
+    if (!writeFull(conn, &status, sizeof(status)) ||
+        !writeFull(conn, &responseLen, sizeof(responseLen)) ||
+        !writeFull(conn, response.data(), responseLen)) return;
   }
-  return is_valid;
 }
 
-void json2FrElements (json val, std::vector<FrElement> & vval){
-  if (!val.is_array()) {
-    FrElement v;
-    std::string s_aux, s;
-    uint base;
-    if (val.is_string()) {
-      s_aux = val.get<std::string>();
-      std::string possible_prefix = s_aux.substr(0, 2);
-      if (possible_prefix == "0b" || possible_prefix == "0B"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 2; 
-      } else if (possible_prefix == "0o" || possible_prefix == "0O"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 8; 
-      } else if (possible_prefix == "0x" || possible_prefix == "0X"){
-        s = s_aux.substr(2, s_aux.size() - 2);
-        base = 16;
-      } else{
-        s = s_aux;
-        base = 10;
-      }
-      if (!check_valid_number(s, base)){
-        std::ostringstream errStrStream;
-        errStrStream << "Invalid number in JSON input: " << s_aux << "\n";
-	      throw std::runtime_error(errStrStream.str() );
-      }
-    } else if (val.is_number()) {
-        double vd = val.get<double>();
-        std::stringstream stream;
-        stream << std::fixed << std::setprecision(0) << vd;
-        s = stream.str();
-        base = 10;
-    } else {
-        std::ostringstream errStrStream;
-        errStrStream << "Invalid JSON type\n";
-	      throw std::runtime_error(errStrStream.str() );
-    }
-    Fr_str2element (&v, s.c_str(), base);
-    vval.push_back(v);
-  } else {
-    for (uint i = 0; i < val.size(); i++) {
-      json2FrElements (val[i], vval);
+static void serveConnections(Circom_Circuit *circuit, int listenFd, uint maxThread) {
+  Circom_CalcWit *ctx = new Circom_CalcWit(circuit, maxThread);
+  for (;;) {
+    int conn = accept(listenFd, NULL, NULL);
+    if (conn == -1) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      handle_error("accept");
     }
+    serveConnection(ctx, conn);
+    close(conn);
   }
 }
 
-
-void loadJson(Circom_CalcWit *ctx, std::string filename) {
-  std::ifstream inStream(filename);
-  json j;
-  inStream >> j;
-  
-  u64 nItems = j.size();
-  // printf("Items : %llu\n",nItems);
-  if (nItems == 0){
-    ctx->tryRunCircuit();
+void runServer(Circom_Circuit *circuit, std::string const &socketPath, uint nContexts) {
+  struct sockaddr_un addr;
+  if (socketPath.size() >= sizeof(addr.sun_path)) {
+    std::cerr << "Socket path too long: " << socketPath << std::endl;
+    exit(EXIT_FAILURE);
   }
-  for (json::iterator it = j.begin(); it != j.end(); ++it) {
-    // std::cout << it.key() << " => " << it.value() << '\n';
-    u64 h = fnv1a(it.key());
-    std::vector<FrElement> v;
-    json2FrElements(it.value(),v);
-    uint signalSize = ctx->getInputSignalSize(h);
-    if (v.size() < signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Not enough values\n";
-	throw std::runtime_error(errStrStream.str() );
-    }
-    if (v.size() > signalSize) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Too many values\n";
-	throw std::runtime_error(errStrStream.str() );
-    }
-    for (uint i = 0; i<v.size(); i++){
-      try {
-	// std::cout << it.key() << "," << i << " => " << Fr_element2str(&(v[i])) << '\n';
-	ctx->setInputSignal(h,i,v[i]);
-      } catch (std::runtime_error e) {
-	std::ostringstream errStrStream;
-	errStrStream << "Error setting signal: " << it.key() << "\n" << e.what();
-	throw std::runtime_error(errStrStream.str() );
-      }
-    }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socketPath.c_str());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) handle_error("socket");
+  unlink(socketPath.c_str());
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) handle_error("bind");
+  if (listen(fd, SOMAXCONN) == -1) handle_error("listen");
+
+  // every worker owns one context and accepts connections on the shared socket
+  std::vector<std::thread> workers;
+  for (uint i = 0; i < nContexts; i++) {
+    workers.push_back(std::thread(serveConnections, circuit, fd, threadsPerContext(nContexts)));
+  }
+  for (uint i = 0; i < nContexts; i++) {
+    workers[i].join();
   }
 }
 
-void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName) {
-    FILE *write_ptr;
-
-    write_ptr = fopen(wtnsFileName.c_str(),"wb");
-
-    fwrite("wtns", 4, 1, write_ptr);
-
-    u32 version = 2;
-    fwrite(&version, 4, 1, write_ptr);
-
-    u32 nSections = 2;
-    fwrite(&nSections, 4, 1, write_ptr);
-
-    // Header
-    u32 idSection1 = 1;
-    fwrite(&idSection1, 4, 1, write_ptr);
-
-    u32 n8 = Fr_N64*8;
-
-    u64 idSection1length = 8 + n8;
-    fwrite(&idSection1length, 8, 1, write_ptr);
-
-    fwrite(&n8, 4, 1, write_ptr);
-
-    fwrite(Fr_q.longVal, Fr_N64*8, 1, write_ptr);
-
-    uint Nwtns = get_size_of_witness();
-    
-    u32 nVars = (u32)Nwtns;
-    fwrite(&nVars, 4, 1, write_ptr);
-
-    // Data
-    u32 idSection2 = 2;
-    fwrite(&idSection2, 4, 1, write_ptr);
-    
-    u64 idSection2length = (u64)n8*(u64)Nwtns;
-    fwrite(&idSection2length, 8, 1, write_ptr);
-
-    FrElement v;
-
-    for (int i=0;i<Nwtns;i++) {
-        ctx->getWitness(i, &v);
-        Fr_toLongNormal(&v, &v);
-        fwrite(v.longVal, Fr_N64*8, 1, write_ptr);
+// Computes the witness of every <input.json> <output.wtns> pair in files on a
+// pool of nThreads workers and reports the throughput. Returns the number of
+// inputs that failed.
+uint runBatch(Circom_Circuit *circuit, uint nThreads, std::vector<std::string> const &files) {
+  uint n = files.size() / 2;
+  std::atomic<uint> failed(0);
+  auto t_start = std::chrono::high_resolution_clock::now();
+  runWitnessBatch(circuit, n, nThreads, [&files, &failed](Circom_CalcWit *ctx, uint i) {
+    try {
+      std::ifstream inStream(files[2*i]);
+      if (!inStream) throw std::runtime_error("Cannot open input file\n");
+      std::stringstream input;
+      input << inStream.rdbuf();
+      std::string wtns;
+      calcWitness(ctx, input.str(), wtns);
+      std::ofstream outStream(files[2*i+1], std::ios::binary);
+      outStream.write(wtns.data(), wtns.size());
+      if (!outStream) throw std::runtime_error("Cannot write output file\n");
+    } catch (std::exception &e) {
+      std::cerr << files[2*i] << ": " << e.what();
+      failed++;
     }
-    fclose(write_ptr);
+  });
+  auto t_end = std::chrono::high_resolution_clock::now();
+  double secs = std::chrono::duration<double>(t_end-t_start).count();
+  std::cout << "Computed " << n - failed << " of " << n << " witnesses in " << secs << " s ("
+            << (n - failed) / secs << " witnesses/s)" << std::endl;
+  return failed;
 }
 
 int main (int argc, char *argv[]) {
   std::string cl(argv[0]);
-  if (argc!=3) {
-        std::cout << "Usage: " << cl << " <input.json> <output.wtns>\n";
+  bool montgomery = argc==4 && std::string(argv[1]) == "--montgomery";
+  if (argc>=5 && argc%2==1 && std::string(argv[1]) == "--batch") {
+    std::string datfile = cl + ".dat";
+    uint nThreads = atoi(argv[2]);
+    std::vector<std::string> files(argv + 3, argv + argc);
+
+    Circom_Circuit *circuit = loadCircuit(datfile);
+    uint failed = runBatch(circuit, nThreads, files);
+    freeCircuit(circuit);
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  } else if (argc>=3 && argc<=4 && std::string(argv[1]) == "--server") {
+    std::string datfile = cl + ".dat";
+    uint nContexts = argc == 4 ? atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (nContexts == 0) nContexts = 1;
+
+    Circom_Circuit *circuit = loadCircuit(datfile);
+    runServer(circuit, argv[2], nContexts);
+    freeCircuit(circuit);
+  } else if (argc==4 && std::string(argv[1]) == "--json2bin") {
+    std::string datfile = cl + ".dat";
+    std::ifstream inStream(argv[2]);
+    if (!inStream) {
+      std::cerr << "Cannot open input file " << argv[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::stringstream input;
+    input << inStream.rdbuf();
+
+    Circom_Circuit *circuit = loadCircuit(datfile);
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 1);
+    std::string bin;
+    bool converted = true;
+    try {
+      json2BinInput(ctx, input.str(), bin);
+    } catch (std::exception &e) {
+      std::cerr << argv[2] << ": " << e.what();
+      converted = false;
+    }
+    delete ctx;
+    freeCircuit(circuit);
+    if (!converted) return EXIT_FAILURE;
+    std::ofstream outStream(argv[3], std::ios::binary);
+    outStream.write(bin.data(), bin.size());
+    if (!outStream) {
+      std::cerr << "Cannot write output file " << argv[3] << std::endl;
+      return EXIT_FAILURE;
+    }
+  } else if (argc!=3 && !montgomery) {
+        std::cout << "Usage: " << cl << " [--montgomery] <input.json|input.bin> <output.wtns>\n";
+        std::cout << "       " << cl << " --batch <threads> <input.json> <output.wtns> [<input.json> <output.wtns> ...]\n";
+        std::cout << "       " << cl << " --server <socket> [<contexts>]\n";
+        std::cout << "       " << cl << " --json2bin <input.json> <input.bin>\n";
   } else {
     std::string datfile = cl + ".dat";
-    std::string jsonfile(argv[1]);
-    std::string wtnsfile(argv[2]);
+    std::string jsonfile(argv[argc-2]);
+    std::string wtnsfile(argv[argc-1]);
   
     // auto t_start = std::chrono::high_resolution_clock::now();
 
    Circom_Circuit *circuit = loadCircuit(datfile);
 
-   Circom_CalcWit *ctx = new Circom_CalcWit(circuit);
+   Circom_CalcWit *ctx = new Circom_CalcWit(circuit, threadsPerContext(1));
   
-   loadJson(ctx, jsonfile);
+   loadInput(ctx, jsonfile);
    if (ctx->getRemaingInputsToBeSet()!=0) {
      std::cerr << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << std::endl;
      assert(false);
@@ -278,7 +231,9 @@ int main (int argc, char *argv[]) {
    //auto t_mid = std::chrono::high_resolution_clock::now();
    //std::cout << std::chrono::duration<double, std::milli>(t_mid-t_start).count()<<std::endl;
 
-   writeBinWitness(ctx,wtnsfile);
+   writeBinWitness(ctx,wtnsfile,montgomery);
+   delete ctx;
+   freeCircuit(circuit);
   
    //auto t_end = std::chrono::high_resolution_clock::now();
    //std::cout << std::chrono::duration<double, std::milli>(t_end-t_mid).count()<<std::endl;
@@ -1,66 +1,165 @@
 #include <stdio.h>
 #include <iostream>
 #include <assert.h>
+#include <stdexcept>
 #include "circom.hpp"
 #include "calcwit.hpp"
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx);
-void Num2Bits_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_1_run(uint ctx_index,Circom_CalcWit* ctx);
-void Num2Bits_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Num2Bits_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_2_run(uint ctx_index,Circom_CalcWit* ctx);
-void CompConstant_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void CompConstant_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void CompConstant_3_run(uint ctx_index,Circom_CalcWit* ctx);
-void ecDecompress_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ecDecompress_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void ecDecompress_4_run(uint ctx_index,Circom_CalcWit* ctx);
-void Boolean_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ecDecompress_4_run_parallel(uint ctx_index,Circom_CalcWit* ctx);
+void Boolean_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Boolean_5_run(uint ctx_index,Circom_CalcWit* ctx);
-void Permutation_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Permutation_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Permutation_6_run(uint ctx_index,Circom_CalcWit* ctx);
-void matrixMultiplication_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void matrixMultiplication_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void matrixMultiplication_7_run(uint ctx_index,Circom_CalcWit* ctx);
-void Num2Bits_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void matrixMultiplication_7_run_parallel(uint ctx_index,Circom_CalcWit* ctx);
+void Num2Bits_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Num2Bits_8_run(uint ctx_index,Circom_CalcWit* ctx);
-void Edwards2Montgomery_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Edwards2Montgomery_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Edwards2Montgomery_9_run(uint ctx_index,Circom_CalcWit* ctx);
-void MontgomeryDouble_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void MontgomeryDouble_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void MontgomeryDouble_10_run(uint ctx_index,Circom_CalcWit* ctx);
-void MultiMux3_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void MultiMux3_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void MultiMux3_11_run(uint ctx_index,Circom_CalcWit* ctx);
-void MontgomeryAdd_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void MontgomeryAdd_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void MontgomeryAdd_12_run(uint ctx_index,Circom_CalcWit* ctx);
-void WindowMulFix_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void WindowMulFix_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void WindowMulFix_13_run(uint ctx_index,Circom_CalcWit* ctx);
-void Montgomery2Edwards_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Montgomery2Edwards_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Montgomery2Edwards_14_run(uint ctx_index,Circom_CalcWit* ctx);
-void BabyAdd_15_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void BabyAdd_15_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void BabyAdd_15_run(uint ctx_index,Circom_CalcWit* ctx);
-void SegmentMulFix_16_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void SegmentMulFix_16_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void SegmentMulFix_16_run(uint ctx_index,Circom_CalcWit* ctx);
-void SegmentMulFix_17_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void SegmentMulFix_17_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void SegmentMulFix_17_run(uint ctx_index,Circom_CalcWit* ctx);
-void EscalarMulFix_18_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void EscalarMulFix_18_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void EscalarMulFix_18_run(uint ctx_index,Circom_CalcWit* ctx);
-void IsZero_19_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void IsZero_19_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void IsZero_19_run(uint ctx_index,Circom_CalcWit* ctx);
-void Multiplexor2_20_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void Multiplexor2_20_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void Multiplexor2_20_run(uint ctx_index,Circom_CalcWit* ctx);
-void BitElementMulAny_21_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void BitElementMulAny_21_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void BitElementMulAny_21_run(uint ctx_index,Circom_CalcWit* ctx);
-void SegmentMulAny_22_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void SegmentMulAny_22_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void SegmentMulAny_22_run(uint ctx_index,Circom_CalcWit* ctx);
-void SegmentMulAny_23_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void SegmentMulAny_23_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void SegmentMulAny_23_run(uint ctx_index,Circom_CalcWit* ctx);
-void EscalarMulAny_24_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void EscalarMulAny_24_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void EscalarMulAny_24_run(uint ctx_index,Circom_CalcWit* ctx);
-void ElGamalEncrypt_25_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ElGamalEncrypt_25_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
 void ElGamalEncrypt_25_run(uint ctx_index,Circom_CalcWit* ctx);
-void ShuffleEncryptTemplate_26_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ElGamalEncrypt_25_run_precompute(uint ctx_index,Circom_CalcWit* ctx);
+void ElGamalEncrypt_25_run_precompute_parallel(uint ctx_index,Circom_CalcWit* ctx);
+void ElGamalEncrypt_25_run_parallel(uint ctx_index,Circom_CalcWit* ctx);
+void ShuffleEncryptTemplate_26_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
+void ShuffleEncryptTemplate_26_create_precomputed(uint ctx_index,Circom_CalcWit* ctx);
 void ShuffleEncryptTemplate_26_run(uint ctx_index,Circom_CalcWit* ctx);
-void ShuffleEncryptV2Template_27_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ShuffleEncryptV2Template_27_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
+void ShuffleEncryptV2Template_27_create_precomputed(uint ctx_index,Circom_CalcWit* ctx);
 void ShuffleEncryptV2Template_27_run(uint ctx_index,Circom_CalcWit* ctx);
-void ShuffleEncryptV2_28_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
+void ShuffleEncryptV2_28_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather);
+void ShuffleEncryptV2_28_create_precomputed(uint ctx_index,Circom_CalcWit* ctx);
 void ShuffleEncryptV2_28_run(uint ctx_index,Circom_CalcWit* ctx);
+const char* templateNames[29] = { 
+"Num2Bits",
+"Num2Bits",
+"Num2Bits",
+"CompConstant",
+"ecDecompress",
+"Boolean",
+"Permutation",
+"matrixMultiplication",
+"Num2Bits",
+"Edwards2Montgomery",
+"MontgomeryDouble",
+"MultiMux3",
+"MontgomeryAdd",
+"WindowMulFix",
+"Montgomery2Edwards",
+"BabyAdd",
+"SegmentMulFix",
+"SegmentMulFix",
+"EscalarMulFix",
+"IsZero",
+"Multiplexor2",
+"BitElementMulAny",
+"SegmentMulAny",
+"SegmentMulAny",
+"EscalarMulAny",
+"ElGamalEncrypt",
+"ShuffleEncryptTemplate",
+"ShuffleEncryptV2Template",
+"ShuffleEncryptV2" };
+uint componentDimensions_4[1] = {2704};
+uint componentDimensions_14[1] = {83};
+uint componentDimensions_15[1] = {83};
+uint componentDimensions_16[1] = {83};
+uint componentDimensions_29[1] = {147};
+uint componentDimensions_32[1] = {102};
+uint componentDimensions_41[1] = {4};
+uint componentDimensions_42[1] = {52};
+uint componentDimensions_47[1] = {208};
+Circom_ComponentName componentNames[50] = { 
+{"main",NULL,0},
+{"num2bits",NULL,0},
+{"n2b",NULL,0},
+{"cmp",NULL,0},
+{"boolean_check",componentDimensions_4,1},
+{"mux",NULL,0},
+{"dbl2",NULL,0},
+{"adr3",NULL,0},
+{"adr4",NULL,0},
+{"adr5",NULL,0},
+{"adr6",NULL,0},
+{"adr7",NULL,0},
+{"adr8",NULL,0},
+{"e2m",NULL,0},
+{"windows",componentDimensions_14,1},
+{"adders",componentDimensions_15,1},
+{"cadders",componentDimensions_16,1},
+{"dblLast",NULL,0},
+{"m2e",NULL,0},
+{"cm2e",NULL,0},
+{"cAdd",NULL,0},
+{"windows",NULL,0},
+{"adders",NULL,0},
+{"cadders",NULL,0},
+{"segments[0]",NULL,0},
+{"segments[1]",NULL,0},
+{"doubler",NULL,0},
+{"adder",NULL,0},
+{"selector",NULL,0},
+{"bits",componentDimensions_29,1},
+{"eadder",NULL,0},
+{"lastSel",NULL,0},
+{"bits",componentDimensions_32,1},
+{"doublers",NULL,0},
+{"zeropoint",NULL,0},
+{"bitDecomposition",NULL,0},
+{"computeC0",NULL,0},
+{"adder0",NULL,0},
+{"computeC1",NULL,0},
+{"adder1",NULL,0},
+{"permutation",NULL,0},
+{"shuffle",componentDimensions_41,1},
+{"elgamal",componentDimensions_42,1},
+{"n2b_u0",NULL,0},
+{"n2b_u1",NULL,0},
+{"n2b_v0",NULL,0},
+{"n2b_v1",NULL,0},
+{"decompress",componentDimensions_47,1},
+{"shuffleEncryptV1",NULL,0},
+{"shuffle_encrypt",NULL,0} };
 Circom_TemplateFunction _functionTable[29] = { 
 Num2Bits_0_run,
 Num2Bits_1_run,
@@ -96,8 +195,10 @@ NULL,
 NULL,
 NULL,
 NULL,
+ecDecompress_4_run_parallel,
 NULL,
 NULL,
+matrixMultiplication_7_run_parallel,
 NULL,
 NULL,
 NULL,
@@ -115,12 +216,55 @@ NULL,
 NULL,
 NULL,
 NULL,
-NULL,
-NULL,
-NULL,
+ElGamalEncrypt_25_run_parallel,
 NULL,
 NULL,
 NULL };
+uint templateSubcomponents_3[2] = {2,1};
+uint templateSubcomponents_4[4] = {1,1,3,1};
+uint templateSubcomponents_6[2] = {5,2704};
+uint templateSubcomponents_13[6] = {10,1,11,1,12,6};
+uint templateSubcomponents_16[12] = {9,1,10,1,12,166,13,83,14,2,15,1};
+uint templateSubcomponents_17[12] = {9,1,10,1,12,2,13,1,14,2,15,1};
+uint templateSubcomponents_18[8] = {14,1,15,1,16,1,17,1};
+uint templateSubcomponents_21[6] = {10,1,12,1,20,1};
+uint templateSubcomponents_22[10] = {9,1,14,1,15,1,20,1,21,147};
+uint templateSubcomponents_23[10] = {9,1,14,1,15,1,20,1,21,102};
+uint templateSubcomponents_24[12] = {10,1,14,1,15,1,19,1,22,1,23,1};
+uint templateSubcomponents_25[8] = {8,1,15,2,18,1,24,1};
+uint templateSubcomponents_26[6] = {6,1,7,4,25,52};
+uint templateSubcomponents_27[6] = {0,4,4,208,26,1};
+uint templateSubcomponents_28[2] = {27,1};
+Circom_TemplateArena templateArenas[29] = { 
+{0,NULL,0},
+{0,NULL,0},
+{0,NULL,0},
+{8,templateSubcomponents_3,1},
+{8,templateSubcomponents_4,2},
+{0,NULL,0},
+{10816,templateSubcomponents_6,1},
+{0,NULL,0},
+{0,NULL,0},
+{0,NULL,0},
+{0,NULL,0},
+{0,NULL,0},
+{0,NULL,0},
+{32,templateSubcomponents_13,3},
+{0,NULL,0},
+{0,NULL,0},
+{1016,templateSubcomponents_16,6},
+{32,templateSubcomponents_17,6},
+{16,templateSubcomponents_18,4},
+{0,NULL,0},
+{0,NULL,0},
+{16,templateSubcomponents_21,3},
+{608,templateSubcomponents_22,5},
+{424,templateSubcomponents_23,5},
+{24,templateSubcomponents_24,6},
+{24,templateSubcomponents_25,4},
+{296,templateSubcomponents_26,3},
+{1072,templateSubcomponents_27,3},
+{8,templateSubcomponents_28,1} };
 uint get_main_input_signal_start() {return 2;}
 
 uint get_main_input_signal_no() {return 3178;}
@@ -129,6 +273,8 @@ uint get_total_signal_no() {return 1127640;}
 
 uint get_number_of_components() {return 105156;}
 
+uint get_number_of_templates() {return 29;}
+
 uint get_size_of_input_hashmap() {return 256;}
 
 uint get_size_of_witness() {return 280701;}
@@ -137,342 +283,107 @@ uint get_size_of_constants() {return 34;}
 
 uint get_size_of_io_map() {return 4;}
 
-void release_memory_component(Circom_CalcWit* ctx, uint pos) {{
-
-if (pos != 0){{
-
-if(ctx->componentMemory[pos].subcomponents)
-delete []ctx->componentMemory[pos].subcomponents;
-
-if(ctx->componentMemory[pos].subcomponentsParallel)
-delete []ctx->componentMemory[pos].subcomponentsParallel;
-
-if(ctx->componentMemory[pos].outputIsSet)
-delete []ctx->componentMemory[pos].outputIsSet;
-
-if(ctx->componentMemory[pos].mutexes)
-delete []ctx->componentMemory[pos].mutexes;
-
-if(ctx->componentMemory[pos].cvs)
-delete []ctx->componentMemory[pos].cvs;
-
-if(ctx->componentMemory[pos].sbct)
-delete []ctx->componentMemory[pos].sbct;
-
-}}
-
-
-}}
-
 
 // function declarations
 // template declarations
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 0;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[0];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[4];
 uint sub_component_aux;
 uint index_multiple_eq;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[0]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[0]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];
-// load src
-Fr_shr(&expaux[1],&signalValues[mySignalStart + 52],&lvar[3]); // line circom 32
-Fr_band(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_sub(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[2]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom 34
-Fr_add(&expaux[0],&lvar[1],&expaux[1]); // line circom 34
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom 35
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[0]); // line circom 31
-}
-Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 52]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+// out[i] <-- (in >> i) & 1 for all bits in one native pass, the bits are 0/1 by construction
+bool bitsAddUp = Fr_toBits(&signalValues[mySignalStart + 0],&signalValues[mySignalStart + 52],52); // line circom 31
+if (!bitsAddUp) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+assert(bitsAddUp);
 }
 
-void Num2Bits_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 1;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Num2Bits_1_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[1];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[4];
 uint sub_component_aux;
 uint index_multiple_eq;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[3]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[3]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];
-// load src
-Fr_shr(&expaux[1],&signalValues[mySignalStart + 254],&lvar[3]); // line circom 32
-Fr_band(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_sub(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[2]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom 34
-Fr_add(&expaux[0],&lvar[1],&expaux[1]); // line circom 34
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom 35
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[3]); // line circom 31
-}
-Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 254]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+// out[i] <-- (in >> i) & 1 for all bits in one native pass, the bits are 0/1 by construction
+bool bitsAddUp = Fr_toBits(&signalValues[mySignalStart + 0],&signalValues[mySignalStart + 254],254); // line circom 31
+if (!bitsAddUp) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+assert(bitsAddUp);
 }
 
-void Num2Bits_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 2;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Num2Bits_2_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[2];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[4];
 uint sub_component_aux;
 uint index_multiple_eq;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[4]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[4]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];
-// load src
-Fr_shr(&expaux[1],&signalValues[mySignalStart + 135],&lvar[3]); // line circom 32
-Fr_band(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_sub(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[2]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom 34
-Fr_add(&expaux[0],&lvar[1],&expaux[1]); // line circom 34
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom 35
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[4]); // line circom 31
-}
-Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 135]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+// out[i] <-- (in >> i) & 1 for all bits in one native pass, the bits are 0/1 by construction
+bool bitsAddUp = Fr_toBits(&signalValues[mySignalStart + 0],&signalValues[mySignalStart + 135],135); // line circom 31
+if (!bitsAddUp) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+assert(bitsAddUp);
 }
 
-void CompConstant_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void CompConstant_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 3;
-ctx->componentMemory[coffset].templateName = "CompConstant";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 254;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(1);
 }
 
 void CompConstant_3_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[3];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -494,8 +405,7 @@ uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+383;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "num2bits";
-Num2Bits_2_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_2_create(csoffset,aux_cmp_num,ctx,1,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 136 ;
 aux_cmp_num += 1;
@@ -722,27 +632,22 @@ PFrElement aux_dest = &signalValues[mySignalStart + 0];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 127]);
 }
-for (uint i = 0; i < 1; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void ecDecompress_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void ecDecompress_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 4;
-ctx->componentMemory[coffset].templateName = "ecDecompress";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 3;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[2]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(2);
 }
 
 void ecDecompress_4_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[4];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -758,8 +663,7 @@ uint aux_create = 0;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+527;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b";
-Num2Bits_1_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_1_create(csoffset,aux_cmp_num,ctx,2,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 255 ;
 aux_cmp_num += 1;
@@ -770,8 +674,7 @@ uint aux_create = 1;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+8;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cmp";
-CompConstant_3_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+CompConstant_3_create(csoffset,aux_cmp_num,ctx,3,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 519 ;
 aux_cmp_num += 2;
@@ -868,27 +771,27 @@ Fr_add(&expaux[0],&signalValues[mySignalStart + 6],&signalValues[mySignalStart +
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-for (uint i = 0; i < 2; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
+
+void ecDecompress_4_run_parallel(uint ctx_index,Circom_CalcWit* ctx){
+ecDecompress_4_run(ctx_index,ctx);
+ctx->componentMemory[ctx_index].hasRun = true;
 }
 
-void Boolean_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Boolean_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 5;
-ctx->componentMemory[coffset].templateName = "Boolean";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Boolean_5_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[5];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -904,27 +807,22 @@ Fr_mul(&expaux[1],&signalValues[mySignalStart + 0],&expaux[2]); // line circom 6
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 6
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 6. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void Permutation_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Permutation_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 6;
-ctx->componentMemory[coffset].templateName = "Permutation";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2704;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[2704]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(2704);
 }
 
 void Permutation_6_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[6];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -945,10 +843,8 @@ Fr_copy(aux_dest,&circuitConstants[0]);
 uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+2704;
-uint aux_dimensions[1] = {2704};
 for (uint i = 0; i < 2704; i++) {
-std::string new_cmp_name = "boolean_check"+ctx->generate_position_array(aux_dimensions, 1, i);
-Boolean_5_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Boolean_5_create(csoffset,aux_cmp_num,ctx,4,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 1 ;
 aux_cmp_num += 1;
@@ -1091,27 +987,22 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[2],&circuitConstants[0]); // line circom 21
 }
-for (uint i = 0; i < 2704; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void matrixMultiplication_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void matrixMultiplication_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 7;
-ctx->componentMemory[coffset].templateName = "matrixMultiplication";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2756;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void matrixMultiplication_7_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[7];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -1148,6 +1039,25 @@ PFrElement aux_dest = &lvar[3];
 // end load src
 Fr_copy(aux_dest,&circuitConstants[1]);
 }
+// Rows of A that are 0/1, as every row of a permutation matrix, pick the
+// B[j] to add up instead of multiplying by them
+PFrElement aRow = &signalValues[mySignalStart + ((Fr_toInt(&lvar[2]) * 52) + 52)];
+bool aRowIsBinary = true;
+for (uint j = 0; j < 52; j++) {
+aRowIsBinary = aRowIsBinary && aRow[j].type == Fr_SHORT && (aRow[j].shortVal == 0 || aRow[j].shortVal == 1);
+}
+if (aRowIsBinary) {
+PFrElement intermediateRow = &signalValues[mySignalStart + ((Fr_toInt(&lvar[2]) * 52) + 2808)];
+for (uint j = 0; j < 52; j++) {
+if (aRow[j].shortVal) {
+Fr_copy(&intermediateRow[j],&signalValues[mySignalStart + (j + 2756)]);
+Fr_add(&expaux[0],&lvar[3],&intermediateRow[j]); // line circom 14
+Fr_copy(&lvar[3],&expaux[0]);
+} else {
+Fr_copy(&intermediateRow[j],&circuitConstants[1]);
+}
+}
+} else {
 {
 PFrElement aux_dest = &lvar[4];
 // load src
@@ -1179,6 +1089,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 12
 }
+}
 {
 PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[2])) + 0)];
 // load src
@@ -1194,147 +1105,81 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[2],&circuitConstants[0]); // line circom 10
 }
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
+
+void matrixMultiplication_7_run_parallel(uint ctx_index,Circom_CalcWit* ctx){
+matrixMultiplication_7_run(ctx_index,ctx);
+ctx->componentMemory[ctx_index].hasRun = true;
 }
 
-void Num2Bits_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Num2Bits_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 8;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Num2Bits_8_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[8];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[4];
 uint sub_component_aux;
 uint index_multiple_eq;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[12]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];
-// load src
-Fr_shr(&expaux[1],&signalValues[mySignalStart + 251],&lvar[3]); // line circom 32
-Fr_band(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_sub(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[2]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom 34
-Fr_add(&expaux[0],&lvar[1],&expaux[1]); // line circom 34
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom 35
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 31
-}
-Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 251]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+// out[i] <-- (in >> i) & 1 for all bits in one native pass, the bits are 0/1 by construction
+bool bitsAddUp = Fr_toBits(&signalValues[mySignalStart + 0],&signalValues[mySignalStart + 251],251); // line circom 31
+if (!bitsAddUp) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
+assert(bitsAddUp);
 }
 
-void Edwards2Montgomery_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Edwards2Montgomery_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 9;
-ctx->componentMemory[coffset].templateName = "Edwards2Montgomery";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Edwards2Montgomery_9_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[9];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
+FrElement expaux[6];
 FrElement lvar[0];
 uint sub_component_aux;
 uint index_multiple_eq;
+// the denominators of lines 34 and 35 are inverted together
+Fr_sub(&expaux[2],&circuitConstants[2],&signalValues[mySignalStart + 3]); // line circom 34
+Fr_copy(&expaux[3],&signalValues[mySignalStart + 2]); // line circom 35
+Fr_batchInv(&expaux[4],&expaux[2],2);
 {
 PFrElement aux_dest = &signalValues[mySignalStart + 0];
 // load src
 Fr_add(&expaux[1],&circuitConstants[2],&signalValues[mySignalStart + 3]); // line circom 34
-Fr_sub(&expaux[2],&circuitConstants[2],&signalValues[mySignalStart + 3]); // line circom 34
-Fr_div(&expaux[0],&expaux[1],&expaux[2]); // line circom 34
+Fr_mul(&expaux[0],&expaux[1],&expaux[4]); // line circom 34
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
 {
 PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // load src
-Fr_div(&expaux[0],&signalValues[mySignalStart + 0],&signalValues[mySignalStart + 2]); // line circom 35
+Fr_mul(&expaux[0],&signalValues[mySignalStart + 0],&expaux[5]); // line circom 35
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
@@ -1348,27 +1193,22 @@ Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart +
 Fr_eq(&expaux[0],&expaux[1],&signalValues[mySignalStart + 0]); // line circom 39
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 39. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void MontgomeryDouble_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void MontgomeryDouble_10_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 10;
-ctx->componentMemory[coffset].templateName = "MontgomeryDouble";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void MontgomeryDouble_10_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[10];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -1451,27 +1291,22 @@ Fr_sub(&expaux[0],&expaux[1],&signalValues[mySignalStart + 3]); // line circom 1
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void MultiMux3_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void MultiMux3_11_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 11;
-ctx->componentMemory[coffset].templateName = "MultiMux3";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 19;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void MultiMux3_11_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[11];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -1599,27 +1434,22 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[1],&circuitConstants[8]); // line circom 40
 }
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void MontgomeryAdd_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void MontgomeryAdd_12_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 12;
-ctx->componentMemory[coffset].templateName = "MontgomeryAdd";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 4;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void MontgomeryAdd_12_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[12];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -1689,27 +1519,23 @@ Fr_sub(&expaux[0],&expaux[1],&signalValues[mySignalStart + 3]); // line circom 1
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void WindowMulFix_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void WindowMulFix_13_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 13;
-ctx->componentMemory[coffset].templateName = "WindowMulFix";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 5;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[8]{0};
+ctx->componentMemory[coffset].fixedSignals = NULL;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(8);
 }
 
 void WindowMulFix_13_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[13];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -1725,8 +1551,7 @@ uint aux_create = 0;
 int aux_cmp_num = 7+ctx_index+1;
 uint csoffset = mySignalStart+57;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "mux";
-MultiMux3_11_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MultiMux3_11_create(csoffset,aux_cmp_num,ctx,5,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 38 ;
 aux_cmp_num += 1;
@@ -1737,8 +1562,7 @@ uint aux_create = 1;
 int aux_cmp_num = 6+ctx_index+1;
 uint csoffset = mySignalStart+51;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "dbl2";
-MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,6,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 1;
@@ -1749,8 +1573,7 @@ uint aux_create = 2;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+9;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr3";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,7,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1761,8 +1584,7 @@ uint aux_create = 3;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+16;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr4";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,8,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1773,8 +1595,7 @@ uint aux_create = 4;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+23;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr5";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,9,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1785,8 +1606,7 @@ uint aux_create = 5;
 int aux_cmp_num = 3+ctx_index+1;
 uint csoffset = mySignalStart+30;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr6";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,10,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1797,8 +1617,7 @@ uint aux_create = 6;
 int aux_cmp_num = 4+ctx_index+1;
 uint csoffset = mySignalStart+37;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr7";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,11,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1809,8 +1628,7 @@ uint aux_create = 7;
 int aux_cmp_num = 5+ctx_index+1;
 uint csoffset = mySignalStart+44;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adr8";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,12,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -1899,7 +1717,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 8]);
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],6);
+else MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -1972,7 +1791,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[1]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2045,7 +1865,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[2]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2118,7 +1939,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[3]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2191,7 +2013,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[4]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2264,7 +2087,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[5]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2337,7 +2161,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[6]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 0;
@@ -2388,41 +2213,40 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 1]);
 }
-for (uint i = 0; i < 8; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void Montgomery2Edwards_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Montgomery2Edwards_14_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 14;
-ctx->componentMemory[coffset].templateName = "Montgomery2Edwards";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Montgomery2Edwards_14_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[14];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
+FrElement expaux[6];
 FrElement lvar[0];
 uint sub_component_aux;
 uint index_multiple_eq;
+// the denominators of lines 53 and 54 are inverted together
+Fr_copy(&expaux[2],&signalValues[mySignalStart + 3]); // line circom 53
+Fr_add(&expaux[3],&signalValues[mySignalStart + 2],&circuitConstants[2]); // line circom 54
+Fr_batchInv(&expaux[4],&expaux[2],2);
 {
 PFrElement aux_dest = &signalValues[mySignalStart + 0];
 // load src
-Fr_div(&expaux[0],&signalValues[mySignalStart + 2],&signalValues[mySignalStart + 3]); // line circom 53
+Fr_mul(&expaux[0],&signalValues[mySignalStart + 2],&expaux[4]); // line circom 53
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
@@ -2430,8 +2254,7 @@ Fr_copy(aux_dest,&expaux[0]);
 PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // load src
 Fr_sub(&expaux[1],&signalValues[mySignalStart + 2],&circuitConstants[2]); // line circom 54
-Fr_add(&expaux[2],&signalValues[mySignalStart + 2],&circuitConstants[2]); // line circom 54
-Fr_div(&expaux[0],&expaux[1],&expaux[2]); // line circom 54
+Fr_mul(&expaux[0],&expaux[1],&expaux[5]); // line circom 54
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
@@ -2445,34 +2268,29 @@ Fr_sub(&expaux[2],&signalValues[mySignalStart + 2],&circuitConstants[2]); // lin
 Fr_eq(&expaux[0],&expaux[1],&expaux[2]); // line circom 57
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 57. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void BabyAdd_15_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void BabyAdd_15_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 15;
-ctx->componentMemory[coffset].templateName = "BabyAdd";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 4;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void BabyAdd_15_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[15];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
 bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
 FrElement* circuitConstants = ctx->circuitConstants;
 std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[6];
+FrElement expaux[8];
 FrElement lvar[2];
 uint sub_component_aux;
 uint index_multiple_eq;
@@ -2519,13 +2337,16 @@ Fr_mul(&expaux[0],&signalValues[mySignalStart + 6],&signalValues[mySignalStart +
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
+// the denominators of lines 45 and 48 are inverted together
+Fr_mul(&expaux[3],&circuitConstants[10],&signalValues[mySignalStart + 9]); // line circom 45
+Fr_add(&expaux[4],&circuitConstants[2],&expaux[3]); // line circom 45
+Fr_sub(&expaux[5],&circuitConstants[2],&expaux[3]); // line circom 48
+Fr_batchInv(&expaux[6],&expaux[4],2);
 {
 PFrElement aux_dest = &signalValues[mySignalStart + 0];
 // load src
 Fr_add(&expaux[1],&signalValues[mySignalStart + 6],&signalValues[mySignalStart + 7]); // line circom 45
-Fr_mul(&expaux[4],&circuitConstants[10],&signalValues[mySignalStart + 9]); // line circom 45
-Fr_add(&expaux[2],&circuitConstants[2],&expaux[4]); // line circom 45
-Fr_div(&expaux[0],&expaux[1],&expaux[2]); // line circom 45
+Fr_mul(&expaux[0],&expaux[1],&expaux[6]); // line circom 45
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
@@ -2542,9 +2363,7 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 Fr_mul(&expaux[3],&circuitConstants[9],&signalValues[mySignalStart + 6]); // line circom 48
 Fr_add(&expaux[2],&signalValues[mySignalStart + 8],&expaux[3]); // line circom 48
 Fr_sub(&expaux[1],&expaux[2],&signalValues[mySignalStart + 7]); // line circom 48
-Fr_mul(&expaux[4],&circuitConstants[10],&signalValues[mySignalStart + 9]); // line circom 48
-Fr_sub(&expaux[2],&circuitConstants[2],&expaux[4]); // line circom 48
-Fr_div(&expaux[0],&expaux[1],&expaux[2]); // line circom 48
+Fr_mul(&expaux[0],&expaux[1],&expaux[7]); // line circom 48
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
@@ -2557,27 +2376,23 @@ Fr_sub(&expaux[2],&expaux[3],&signalValues[mySignalStart + 7]); // line circom 4
 Fr_eq(&expaux[0],&expaux[1],&expaux[2]); // line circom 49
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 49. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void SegmentMulFix_16_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void SegmentMulFix_16_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 16;
-ctx->componentMemory[coffset].templateName = "SegmentMulFix";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 251;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[254]{0};
+ctx->componentMemory[coffset].fixedSignals = NULL;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(254);
 }
 
 void SegmentMulFix_16_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[16];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -2599,8 +2414,7 @@ uint aux_create = 0;
 int aux_cmp_num = 169+ctx_index+1;
 uint csoffset = mySignalStart+1437;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "e2m";
-Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,13,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -2610,11 +2424,10 @@ aux_cmp_num += 1;
 uint aux_create = 1;
 int aux_cmp_num = 171+ctx_index+1;
 uint csoffset = mySignalStart+1445;
-uint aux_dimensions[1] = {83};
 for (uint i = 0; i < 83; i++) {
-std::string new_cmp_name = "windows"+ctx->generate_position_array(aux_dimensions, 1, i);
-WindowMulFix_13_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+WindowMulFix_13_create(csoffset,aux_cmp_num,ctx,14,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->componentMemory[aux_cmp_num].fixedSignals = ctx->componentMemory[ctx_index].fixedSignals + (csoffset - mySignalStart);
 csoffset += 95 ;
 aux_cmp_num += 9;
 }
@@ -2623,10 +2436,8 @@ aux_cmp_num += 9;
 uint aux_create = 84;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+255;
-uint aux_dimensions[1] = {83};
 for (uint i = 0; i < 83; i++) {
-std::string new_cmp_name = "adders"+ctx->generate_position_array(aux_dimensions, 1, i);
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,15,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -2636,10 +2447,8 @@ aux_cmp_num += 1;
 uint aux_create = 167;
 int aux_cmp_num = 84+ctx_index+1;
 uint csoffset = mySignalStart+846;
-uint aux_dimensions[1] = {83};
 for (uint i = 0; i < 83; i++) {
-std::string new_cmp_name = "cadders"+ctx->generate_position_array(aux_dimensions, 1, i);
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,16,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -2650,8 +2459,7 @@ uint aux_create = 250;
 int aux_cmp_num = 168+ctx_index+1;
 uint csoffset = mySignalStart+1431;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "dblLast";
-MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,17,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 1;
@@ -2662,8 +2470,7 @@ uint aux_create = 251;
 int aux_cmp_num = 170+ctx_index+1;
 uint csoffset = mySignalStart+1441;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -2674,8 +2481,7 @@ uint aux_create = 252;
 int aux_cmp_num = 167+ctx_index+1;
 uint csoffset = mySignalStart+1427;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cm2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,19,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -2686,8 +2492,7 @@ uint aux_create = 253;
 int aux_cmp_num = 83+ctx_index+1;
 uint csoffset = mySignalStart+836;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cAdd";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,20,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -2728,7 +2533,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 254]);
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Edwards2Montgomery_9_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Edwards2Montgomery_9_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 PFrElement aux_dest = &lvar[1];
@@ -2778,7 +2584,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2792,7 +2599,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2838,7 +2646,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * F
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2853,7 +2662,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * F
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2901,7 +2711,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * F
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2915,7 +2726,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * F
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2930,7 +2742,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[83]].si
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],6);
+else MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2944,7 +2757,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[83]].si
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],6);
+else MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2958,7 +2772,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[250]].s
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -2972,7 +2787,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[250]].s
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3141,7 +2957,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[249]].s
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 253;
@@ -3217,27 +3034,23 @@ PFrElement aux_dest = &signalValues[mySignalStart + 3];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[83]].signalStart + 3]);
 }
-for (uint i = 0; i < 254; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void SegmentMulFix_17_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void SegmentMulFix_17_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 17;
-ctx->componentMemory[coffset].templateName = "SegmentMulFix";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 5;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[8]{0};
+ctx->componentMemory[coffset].fixedSignals = NULL;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(8);
 }
 
 void SegmentMulFix_17_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[17];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -3259,8 +3072,7 @@ uint aux_create = 0;
 int aux_cmp_num = 5+ctx_index+1;
 uint csoffset = mySignalStart+43;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "e2m";
-Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,13,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -3271,9 +3083,9 @@ uint aux_create = 1;
 int aux_cmp_num = 7+ctx_index+1;
 uint csoffset = mySignalStart+51;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "windows";
-WindowMulFix_13_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+WindowMulFix_13_create(csoffset,aux_cmp_num,ctx,21,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->componentMemory[aux_cmp_num].fixedSignals = ctx->componentMemory[ctx_index].fixedSignals + (csoffset - mySignalStart);
 csoffset += 95 ;
 aux_cmp_num += 9;
 }
@@ -3283,8 +3095,7 @@ uint aux_create = 2;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+9;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adders";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,22,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -3295,8 +3106,7 @@ uint aux_create = 3;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+26;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cadders";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,23,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -3307,8 +3117,7 @@ uint aux_create = 4;
 int aux_cmp_num = 4+ctx_index+1;
 uint csoffset = mySignalStart+37;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "dblLast";
-MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,17,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 1;
@@ -3319,8 +3128,7 @@ uint aux_create = 5;
 int aux_cmp_num = 6+ctx_index+1;
 uint csoffset = mySignalStart+47;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -3331,8 +3139,7 @@ uint aux_create = 6;
 int aux_cmp_num = 3+ctx_index+1;
 uint csoffset = mySignalStart+33;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cm2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,19,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -3343,8 +3150,7 @@ uint aux_create = 7;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+16;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "cAdd";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,20,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -3385,7 +3191,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 8]);
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Edwards2Montgomery_9_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Edwards2Montgomery_9_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 PFrElement aux_dest = &lvar[1];
@@ -3433,7 +3240,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3447,7 +3255,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3504,7 +3313,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[1]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],6);
+else MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3518,7 +3328,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[4]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3532,7 +3343,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[4]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],7);
+else MontgomeryAdd_12_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -3664,7 +3476,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[3]].sig
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
 }
 {
 uint cmp_index_ref = 7;
@@ -3740,27 +3553,23 @@ PFrElement aux_dest = &signalValues[mySignalStart + 3];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[1]].signalStart + 3]);
 }
-for (uint i = 0; i < 8; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void EscalarMulFix_18_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void EscalarMulFix_18_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 18;
-ctx->componentMemory[coffset].templateName = "EscalarMulFix";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 251;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[4]{0};
+ctx->componentMemory[coffset].fixedSignals = NULL;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(4);
 }
 
 void EscalarMulFix_18_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[18];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -3771,6 +3580,9 @@ FrElement expaux[4];
 FrElement lvar[9];
 uint sub_component_aux;
 uint index_multiple_eq;
+// the multiples of BASE are the same in every instance and every witness:
+// once an instance has run, they are copied from its fixed signals
+ctx->componentMemory[ctx_index].fixedSignals = ctx->getFixedSignals(18);
 {
 PFrElement aux_dest = &lvar[0];
 // load src
@@ -3794,9 +3606,9 @@ uint aux_create = 0;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+267;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "segments[0]";
-SegmentMulFix_16_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+SegmentMulFix_16_create(csoffset,aux_cmp_num,ctx,24,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->componentMemory[aux_cmp_num].fixedSignals = ctx->componentMemory[ctx_index].fixedSignals + (csoffset - mySignalStart);
 csoffset += 0 ;
 aux_cmp_num += 0;
 }
@@ -3806,9 +3618,9 @@ uint aux_create = 1;
 int aux_cmp_num = 921+ctx_index+1;
 uint csoffset = mySignalStart+9597;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "segments[1]";
-SegmentMulFix_17_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+SegmentMulFix_17_create(csoffset,aux_cmp_num,ctx,25,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->componentMemory[aux_cmp_num].fixedSignals = ctx->componentMemory[ctx_index].fixedSignals + (csoffset - mySignalStart);
 csoffset += 0 ;
 aux_cmp_num += 0;
 }
@@ -3818,8 +3630,7 @@ uint aux_create = 2;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+263;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -3830,8 +3641,7 @@ uint aux_create = 3;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+253;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adders";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,22,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -4028,7 +3838,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -4042,7 +3853,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
+if (ctx->componentMemory[ctx_index].fixedSignals) ctx->copyFixedSignals(ctx_index,mySubcomponents[cmp_index_ref],4);
+else Montgomery2Edwards_14_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -4160,27 +3972,23 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[3]].signalStart + 1]);
 }
-for (uint i = 0; i < 4; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+if (!ctx->componentMemory[ctx_index].fixedSignals) ctx->publishFixedSignals(18,mySignalStart,9743);
 }
 
-void IsZero_19_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void IsZero_19_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 19;
-ctx->componentMemory[coffset].templateName = "IsZero";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void IsZero_19_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[19];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -4221,27 +4029,22 @@ Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart +
 Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
 if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&expaux[0]));
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void Multiplexor2_20_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void Multiplexor2_20_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 20;
-ctx->componentMemory[coffset].templateName = "Multiplexor2";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 5;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(0);
 }
 
 void Multiplexor2_20_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[20];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -4270,27 +4073,23 @@ Fr_add(&expaux[0],&expaux[1],&signalValues[mySignalStart + 4]); // line circom 3
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-for (uint i = 0; i < 0; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void BitElementMulAny_21_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void BitElementMulAny_21_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 21;
-ctx->componentMemory[coffset].templateName = "BitElementMulAny";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 5;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[3]{0};
+ctx->componentMemory[coffset].sharedWith = 0;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(3);
 }
 
 void BitElementMulAny_21_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[21];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -4306,8 +4105,7 @@ uint aux_create = 0;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+16;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "doubler";
-MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,26,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 1;
@@ -4318,8 +4116,7 @@ uint aux_create = 1;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+9;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adder";
-MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryAdd_12_create(csoffset,aux_cmp_num,ctx,27,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -4330,8 +4127,7 @@ uint aux_create = 2;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+22;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "selector";
-Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,28,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -4372,8 +4168,14 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 6]);
 // need to run sub component
 ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
 assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
+if (ctx->componentMemory[ctx_index].sharedWith) {
+// dblIn is the same as in sharedWith, take the doubling from it
+u32 sharedDoubler = ctx->componentMemory[ctx->componentMemory[ctx_index].sharedWith].subcomponents[cmp_index_ref];
+Fr_copyn(&ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart],&ctx->signalValues[ctx->componentMemory[sharedDoubler].signalStart],6);
+} else {
 MontgomeryDouble_10_run(mySubcomponents[cmp_index_ref],ctx);
 }
+}
 {
 uint cmp_index_ref = 1;
 {
@@ -4496,27 +4298,23 @@ PFrElement aux_dest = &signalValues[mySignalStart + 3];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[2]].signalStart + 1]);
 }
-for (uint i = 0; i < 3; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void SegmentMulAny_22_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void SegmentMulAny_22_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 22;
-ctx->componentMemory[coffset].templateName = "SegmentMulAny";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 150;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[151]{0};
+ctx->componentMemory[coffset].sharedWith = 0;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(151);
 }
 
 void SegmentMulAny_22_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[22];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -4537,11 +4335,10 @@ Fr_copy(aux_dest,&circuitConstants[26]);
 uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+154;
-uint aux_dimensions[1] = {147};
 for (uint i = 0; i < 147; i++) {
-std::string new_cmp_name = "bits"+ctx->generate_position_array(aux_dimensions, 1, i);
-BitElementMulAny_21_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BitElementMulAny_21_create(csoffset,aux_cmp_num,ctx,29,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].sharedWith) ctx->componentMemory[aux_cmp_num].sharedWith = ctx->componentMemory[ctx->componentMemory[ctx_index].sharedWith].subcomponents[aux_create+i];
 csoffset += 29 ;
 aux_cmp_num += 4;
 }
@@ -4551,8 +4348,7 @@ uint aux_create = 147;
 int aux_cmp_num = 588+ctx_index+1;
 uint csoffset = mySignalStart+4417;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "e2m";
-Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,13,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -4563,8 +4359,7 @@ uint aux_create = 148;
 int aux_cmp_num = 591+ctx_index+1;
 uint csoffset = mySignalStart+4438;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -4575,8 +4370,7 @@ uint aux_create = 149;
 int aux_cmp_num = 589+ctx_index+1;
 uint csoffset = mySignalStart+4421;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "eadder";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,30,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -4587,8 +4381,7 @@ uint aux_create = 150;
 int aux_cmp_num = 590+ctx_index+1;
 uint csoffset = mySignalStart+4431;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "lastSel";
-Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,31,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -4946,27 +4739,23 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[150]].signalStart + 1]);
 }
-for (uint i = 0; i < 151; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void SegmentMulAny_23_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void SegmentMulAny_23_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 23;
-ctx->componentMemory[coffset].templateName = "SegmentMulAny";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 105;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[106]{0};
+ctx->componentMemory[coffset].sharedWith = 0;
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(106);
 }
 
 void SegmentMulAny_23_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[23];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -4987,11 +4776,10 @@ Fr_copy(aux_dest,&circuitConstants[29]);
 uint aux_create = 0;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+109;
-uint aux_dimensions[1] = {102};
 for (uint i = 0; i < 102; i++) {
-std::string new_cmp_name = "bits"+ctx->generate_position_array(aux_dimensions, 1, i);
-BitElementMulAny_21_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BitElementMulAny_21_create(csoffset,aux_cmp_num,ctx,32,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
+if (ctx->componentMemory[ctx_index].sharedWith) ctx->componentMemory[aux_cmp_num].sharedWith = ctx->componentMemory[ctx->componentMemory[ctx_index].sharedWith].subcomponents[aux_create+i];
 csoffset += 29 ;
 aux_cmp_num += 4;
 }
@@ -5001,8 +4789,7 @@ uint aux_create = 102;
 int aux_cmp_num = 408+ctx_index+1;
 uint csoffset = mySignalStart+3067;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "e2m";
-Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Edwards2Montgomery_9_create(csoffset,aux_cmp_num,ctx,13,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -5013,8 +4800,7 @@ uint aux_create = 103;
 int aux_cmp_num = 411+ctx_index+1;
 uint csoffset = mySignalStart+3088;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -5025,8 +4811,7 @@ uint aux_create = 104;
 int aux_cmp_num = 409+ctx_index+1;
 uint csoffset = mySignalStart+3071;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "eadder";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,30,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -5037,8 +4822,7 @@ uint aux_create = 105;
 int aux_cmp_num = 410+ctx_index+1;
 uint csoffset = mySignalStart+3081;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "lastSel";
-Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Multiplexor2_20_create(csoffset,aux_cmp_num,ctx,31,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 7 ;
 aux_cmp_num += 1;
@@ -5396,27 +5180,22 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[105]].signalStart + 1]);
 }
-for (uint i = 0; i < 106; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void EscalarMulAny_24_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void EscalarMulAny_24_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 24;
-ctx->componentMemory[coffset].templateName = "EscalarMulAny";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 253;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[6]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(6);
 }
 
 void EscalarMulAny_24_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[24];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -5427,6 +5206,15 @@ FrElement expaux[4];
 FrElement lvar[6];
 uint sub_component_aux;
 uint index_multiple_eq;
+// the doublings of p in the segments only depend on p, which all the
+// instances usually have in common: take them from one that already ran
+u32 sharedWith = ctx->getSharedInstance(24);
+if (sharedWith) {
+u64 sharedSignalStart = ctx->componentMemory[sharedWith].signalStart;
+Fr_eq(&expaux[0],&signalValues[mySignalStart + 253],&signalValues[sharedSignalStart + 253]);
+Fr_eq(&expaux[1],&signalValues[mySignalStart + 254],&signalValues[sharedSignalStart + 254]);
+if (!Fr_isTrue(&expaux[0]) || !Fr_isTrue(&expaux[1])) sharedWith = 0;
+}
 {
 PFrElement aux_dest = &lvar[0];
 // load src
@@ -5438,8 +5226,7 @@ uint aux_create = 0;
 int aux_cmp_num = 3+ctx_index+1;
 uint csoffset = mySignalStart+275;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "segments[0]";
-SegmentMulAny_22_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+SegmentMulAny_22_create(csoffset,aux_cmp_num,ctx,24,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 0 ;
 aux_cmp_num += 0;
@@ -5450,20 +5237,22 @@ uint aux_create = 1;
 int aux_cmp_num = 596+ctx_index+1;
 uint csoffset = mySignalStart+4717;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "segments[1]";
-SegmentMulAny_23_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+SegmentMulAny_23_create(csoffset,aux_cmp_num,ctx,25,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 0 ;
 aux_cmp_num += 0;
 }
 }
+if (sharedWith) {
+ctx->componentMemory[mySubcomponents[0]].sharedWith = ctx->componentMemory[sharedWith].subcomponents[0];
+ctx->componentMemory[mySubcomponents[1]].sharedWith = ctx->componentMemory[sharedWith].subcomponents[1];
+}
 {
 uint aux_create = 2;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+265;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "doublers";
-MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+MontgomeryDouble_10_create(csoffset,aux_cmp_num,ctx,33,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 6 ;
 aux_cmp_num += 1;
@@ -5474,8 +5263,7 @@ uint aux_create = 3;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+271;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "m2e";
-Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Montgomery2Edwards_14_create(csoffset,aux_cmp_num,ctx,18,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 4 ;
 aux_cmp_num += 1;
@@ -5486,8 +5274,7 @@ uint aux_create = 4;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+255;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adders";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,22,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
@@ -5498,8 +5285,7 @@ uint aux_create = 5;
 int aux_cmp_num = 1009+ctx_index+1;
 uint csoffset = mySignalStart+7809;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "zeropoint";
-IsZero_19_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+IsZero_19_create(csoffset,aux_cmp_num,ctx,34,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 3 ;
 aux_cmp_num += 1;
@@ -5829,27 +5615,23 @@ Fr_add(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[4]].si
 // end load src
 Fr_copy(aux_dest,&expaux[0]);
 }
-for (uint i = 0; i < 6; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
+if (!sharedWith) ctx->publishSharedInstance(24,ctx_index);
 }
 
-void ElGamalEncrypt_25_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void ElGamalEncrypt_25_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 25;
-ctx->componentMemory[coffset].templateName = "ElGamalEncrypt";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 7;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[5]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(5);
 }
 
-void ElGamalEncrypt_25_run(uint ctx_index,Circom_CalcWit* ctx){
+void ElGamalEncrypt_25_run_precompute(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[25];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -5883,8 +5665,7 @@ uint aux_create = 0;
 int aux_cmp_num = 2+ctx_index+1;
 uint csoffset = mySignalStart+31;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "bitDecomposition";
-Num2Bits_8_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_8_create(csoffset,aux_cmp_num,ctx,35,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 252 ;
 aux_cmp_num += 1;
@@ -5895,94 +5676,190 @@ uint aux_create = 1;
 int aux_cmp_num = 3+ctx_index+1;
 uint csoffset = mySignalStart+283;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "computeC0";
-EscalarMulFix_18_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+EscalarMulFix_18_create(csoffset,aux_cmp_num,ctx,36,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 9743 ;
 aux_cmp_num += 939;
 }
 }
 {
+uint aux_create = 3;
+int aux_cmp_num = 942+ctx_index+1;
+uint csoffset = mySignalStart+10026;
+for (uint i = 0; i < 1; i++) {
+EscalarMulAny_24_create(csoffset,aux_cmp_num,ctx,38,0,myId);
+mySubcomponents[aux_create+i] = aux_cmp_num;
+csoffset += 7812 ;
+aux_cmp_num += 1011;
+}
+}
+{
+uint cmp_index_ref = 0;
+{
+PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 251];
+// load src
+// end load src
+Fr_copy(aux_dest,&signalValues[mySignalStart + 8]);
+}
+// need to run sub component
+ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
+assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
+Num2Bits_8_run(mySubcomponents[cmp_index_ref],ctx);
+}
+{
+PFrElement aux_dest = &lvar[3];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[1]);
+}
+Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 40
+while(Fr_isTrue(&expaux[0])){
+{
+uint cmp_index_ref = 1;
+{
+PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 2)];
+// load src
+// end load src
+Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 0)]);
+}
+// run sub component if needed
+if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
+EscalarMulFix_18_run(mySubcomponents[cmp_index_ref],ctx);
+
+}
+}
+{
+PFrElement aux_dest = &lvar[3];
+// load src
+Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 40
+// end load src
+Fr_copy(aux_dest,&expaux[0]);
+}
+Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 40
+}
+{
+uint cmp_index_ref = 3;
+{
+PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 253];
+// load src
+// end load src
+Fr_copy(aux_dest,&signalValues[mySignalStart + 9]);
+}
+// run sub component if needed
+if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
+EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
+
+}
+}
+{
+uint cmp_index_ref = 3;
+{
+PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 254];
+// load src
+// end load src
+Fr_copy(aux_dest,&signalValues[mySignalStart + 10]);
+}
+// run sub component if needed
+if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
+EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
+
+}
+}
+{
+PFrElement aux_dest = &lvar[3];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[1]);
+}
+Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 55
+while(Fr_isTrue(&expaux[0])){
+{
+uint cmp_index_ref = 3;
+{
+PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 2)];
+// load src
+// end load src
+Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 0)]);
+}
+// run sub component if needed
+if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
+EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
+
+}
+}
+{
+PFrElement aux_dest = &lvar[3];
+// load src
+Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 55
+// end load src
+Fr_copy(aux_dest,&expaux[0]);
+}
+Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 55
+}
+}
+
+void ElGamalEncrypt_25_run_precompute_parallel(uint ctx_index,Circom_CalcWit* ctx){
+ElGamalEncrypt_25_run_precompute(ctx_index,ctx);
+ctx->componentMemory[ctx_index].hasRun = true;
+}
+
+void ElGamalEncrypt_25_run(uint ctx_index,Circom_CalcWit* ctx){
+FrElement* signalValues = ctx->signalValues;
+u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+const char* myTemplateName = templateNames[25];
+u64 myFather = ctx->componentMemory[ctx_index].idFather;
+u64 myId = ctx_index;
+u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+bool* mySubcomponentsParallel = ctx->componentMemory[ctx_index].subcomponentsParallel;
+FrElement* circuitConstants = ctx->circuitConstants;
+std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
+FrElement expaux[2];
+FrElement lvar[4];
+uint sub_component_aux;
+uint index_multiple_eq;
+{
+PFrElement aux_dest = &lvar[0];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[23]);
+}
+{
+PFrElement aux_dest = &lvar[1];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[24]);
+}
+{
+PFrElement aux_dest = &lvar[2];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[12]);
+}
+// r*G and r*pk only depend on the inputs r and pk, precompute() may have run them
+if (!ctx->precomputed) ElGamalEncrypt_25_run_precompute(ctx_index,ctx);
+{
 uint aux_create = 2;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+11;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adder0";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,37,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
 }
 }
 {
-uint aux_create = 3;
-int aux_cmp_num = 942+ctx_index+1;
-uint csoffset = mySignalStart+10026;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "computeC1";
-EscalarMulAny_24_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-csoffset += 7812 ;
-aux_cmp_num += 1011;
-}
-}
-{
 uint aux_create = 4;
 int aux_cmp_num = 1+ctx_index+1;
 uint csoffset = mySignalStart+21;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "adder1";
-BabyAdd_15_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+BabyAdd_15_create(csoffset,aux_cmp_num,ctx,39,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 10 ;
 aux_cmp_num += 1;
 }
 }
 {
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 251];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 8]);
-}
-// need to run sub component
-ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1;
-assert(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Num2Bits_8_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 40
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = 1;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 2)];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 0)]);
-}
-// run sub component if needed
-if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-EscalarMulFix_18_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 40
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 40
-}
-{
 uint cmp_index_ref = 2;
 {
 PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
@@ -6044,65 +5921,6 @@ PFrElement aux_dest = &signalValues[mySignalStart + 1];
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[2]].signalStart + 1]);
 }
 {
-uint cmp_index_ref = 3;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 253];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 9]);
-}
-// run sub component if needed
-if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-uint cmp_index_ref = 3;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 254];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 10]);
-}
-// run sub component if needed
-if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 55
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = 3;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 2)];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 0)]);
-}
-// run sub component if needed
-if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-EscalarMulAny_24_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 55
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[12]); // line circom 55
-}
-{
 uint cmp_index_ref = 4;
 {
 PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
@@ -6163,27 +5981,59 @@ PFrElement aux_dest = &signalValues[mySignalStart + 3];
 // end load src
 Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[4]].signalStart + 1]);
 }
-for (uint i = 0; i < 5; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
+
+void ElGamalEncrypt_25_run_parallel(uint ctx_index,Circom_CalcWit* ctx){
+ElGamalEncrypt_25_run(ctx_index,ctx);
+ctx->componentMemory[ctx_index].hasRun = true;
 }
 
-void ShuffleEncryptTemplate_26_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void ShuffleEncryptTemplate_26_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 26;
-ctx->componentMemory[coffset].templateName = "ShuffleEncryptTemplate";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 2966;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[57]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(57);
+ctx->componentMemory[coffset].subcomponentsParallel = ctx->allocComponentArray<bool>(57);
+for (uint i = 1; i < 57; i++) ctx->componentMemory[coffset].subcomponentsParallel[i] = true;
+}
+
+// Creates the subcomponents of ShuffleEncryptTemplate_26 that precompute()
+// runs ahead.
+void ShuffleEncryptTemplate_26_create_precomputed(uint ctx_index,Circom_CalcWit* ctx){
+u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+u64 myId = ctx_index;
+u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+{
+uint aux_create = 0;
+int aux_cmp_num = 101608+ctx_index+1;
+uint csoffset = mySignalStart+930958;
+for (uint i = 0; i < 1; i++) {
+Permutation_6_create(csoffset,aux_cmp_num,ctx,40,0,myId);
+mySubcomponents[aux_create+i] = aux_cmp_num;
+csoffset += 5408 ;
+aux_cmp_num += 2705;
+}
+}
+{
+uint aux_create = 5;
+int aux_cmp_num = 0+ctx_index+1;
+uint csoffset = mySignalStart+3382;
+for (uint i = 0; i < 52; i++) {
+ElGamalEncrypt_25_create(csoffset,aux_cmp_num,ctx,42,i,myId);
+mySubcomponents[aux_create+i] = aux_cmp_num;
+csoffset += 17838 ;
+aux_cmp_num += 1954;
+}
+}
 }
 
 void ShuffleEncryptTemplate_26_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[26];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -6218,50 +6068,27 @@ PFrElement aux_dest = &lvar[3];
 // end load src
 Fr_copy(aux_dest,&circuitConstants[0]);
 }
-{
-uint aux_create = 0;
-int aux_cmp_num = 101608+ctx_index+1;
-uint csoffset = mySignalStart+930958;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "permutation";
-Permutation_6_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-csoffset += 5408 ;
-aux_cmp_num += 2705;
-}
-}
+// Permutation_6 created by ShuffleEncryptTemplate_26_create_precomputed
 {
 uint aux_create = 1;
 int aux_cmp_num = 104313+ctx_index+1;
 uint csoffset = mySignalStart+936366;
-uint aux_dimensions[1] = {4};
 for (uint i = 0; i < 4; i++) {
-std::string new_cmp_name = "shuffle"+ctx->generate_position_array(aux_dimensions, 1, i);
-matrixMultiplication_7_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+matrixMultiplication_7_create(csoffset,aux_cmp_num,ctx,41,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 5512 ;
 aux_cmp_num += 1;
 }
 }
-{
-uint aux_create = 5;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3382;
-uint aux_dimensions[1] = {52};
-for (uint i = 0; i < 52; i++) {
-std::string new_cmp_name = "elgamal"+ctx->generate_position_array(aux_dimensions, 1, i);
-ElGamalEncrypt_25_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-csoffset += 17838 ;
-aux_cmp_num += 1954;
-}
-}
+// ElGamalEncrypt_25 created by ShuffleEncryptTemplate_26_create_precomputed
 {
 PFrElement aux_dest = &lvar[4];
 // load src
 // end load src
 Fr_copy(aux_dest,&circuitConstants[1]);
 }
+// A is already checked by precompute()
+if (!ctx->precomputed) {
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[11]); // line circom 25
 while(Fr_isTrue(&expaux[0])){
 {
@@ -6287,6 +6114,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[11]); // line circom 25
 }
+}
 {
 PFrElement aux_dest = &lvar[4];
 // load src
@@ -6313,7 +6141,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[5])) + 208)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-matrixMultiplication_7_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else matrixMultiplication_7_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6344,7 +6173,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * ((Fr_toInt(&lvar[4]) * 52)
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-matrixMultiplication_7_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else matrixMultiplication_7_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6358,6 +6188,24 @@ Fr_copy(aux_dest,&expaux[0]);
 Fr_lt(&expaux[0],&lvar[5],&circuitConstants[0]); // line circom 34
 }
 {
+PFrElement aux_dest = &lvar[4];
+// load src
+Fr_add(&expaux[0],&lvar[4],&circuitConstants[2]); // line circom 29
+// end load src
+Fr_copy(aux_dest,&expaux[0]);
+}
+Fr_lt(&expaux[0],&lvar[4],&circuitConstants[19]); // line circom 29
+}
+ctx->joinParallel(ctx_index,1,4);
+{
+PFrElement aux_dest = &lvar[4];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[1]);
+}
+Fr_lt(&expaux[0],&lvar[4],&circuitConstants[19]); // line circom 29
+while(Fr_isTrue(&expaux[0])){
+{
 PFrElement aux_dest = &lvar[5];
 // load src
 // end load src
@@ -6407,7 +6255,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 3174)
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6421,7 +6270,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * (52 + Fr_toInt(&lvar[4])))
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6435,7 +6285,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * (104 + Fr_toInt(&lvar[4])))
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6449,7 +6300,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * (156 + Fr_toInt(&lvar[4])))
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6463,7 +6315,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 3120)
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6477,7 +6330,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 3172]);
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6491,11 +6345,30 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + 3173]);
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ElGamalEncrypt_25_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
 {
+PFrElement aux_dest = &lvar[4];
+// load src
+Fr_add(&expaux[0],&lvar[4],&circuitConstants[2]); // line circom 42
+// end load src
+Fr_copy(aux_dest,&expaux[0]);
+}
+Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 42
+}
+ctx->joinParallel(ctx_index,5,52);
+{
+PFrElement aux_dest = &lvar[4];
+// load src
+// end load src
+Fr_copy(aux_dest,&circuitConstants[1]);
+}
+Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 42
+while(Fr_isTrue(&expaux[0])){
+{
 PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 0)];
 // load src
 // end load src
@@ -6528,27 +6401,45 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 42
 }
-for (uint i = 0; i < 57; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void ShuffleEncryptV2Template_27_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void ShuffleEncryptV2Template_27_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 27;
-ctx->componentMemory[coffset].templateName = "ShuffleEncryptV2Template";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 3178;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[213]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(213);
+ctx->componentMemory[coffset].subcomponentsParallel = ctx->allocComponentArray<bool>(213);
+for (uint i = 4; i < 212; i++) ctx->componentMemory[coffset].subcomponentsParallel[i] = true;
+}
+
+// Creates the ShuffleEncryptTemplate_26 of ShuffleEncryptV2Template_27 and
+// records it as the component precompute() fills.
+void ShuffleEncryptV2Template_27_create_precomputed(uint ctx_index,Circom_CalcWit* ctx){
+u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+u64 myId = ctx_index;
+u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+{
+uint aux_create = 212;
+int aux_cmp_num = 836+ctx_index+1;
+uint csoffset = mySignalStart+166046;
+for (uint i = 0; i < 1; i++) {
+ShuffleEncryptTemplate_26_create(csoffset,aux_cmp_num,ctx,48,0,myId);
+ShuffleEncryptTemplate_26_create_precomputed(aux_cmp_num,ctx);
+ctx->precomputedComponent = aux_cmp_num;
+mySubcomponents[aux_create+i] = aux_cmp_num;
+csoffset += 958414 ;
+aux_cmp_num += 104318;
+}
+}
 }
 
 void ShuffleEncryptV2Template_27_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[27];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -6588,8 +6479,7 @@ uint aux_create = 0;
 int aux_cmp_num = 832+ctx_index+1;
 uint csoffset = mySignalStart+165834;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b_u0";
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,43,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 53 ;
 aux_cmp_num += 1;
@@ -6600,8 +6490,7 @@ uint aux_create = 1;
 int aux_cmp_num = 833+ctx_index+1;
 uint csoffset = mySignalStart+165887;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b_u1";
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,44,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 53 ;
 aux_cmp_num += 1;
@@ -6612,8 +6501,7 @@ uint aux_create = 2;
 int aux_cmp_num = 834+ctx_index+1;
 uint csoffset = mySignalStart+165940;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b_v0";
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,45,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 53 ;
 aux_cmp_num += 1;
@@ -6624,8 +6512,7 @@ uint aux_create = 3;
 int aux_cmp_num = 835+ctx_index+1;
 uint csoffset = mySignalStart+165993;
 for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b_v1";
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+Num2Bits_0_create(csoffset,aux_cmp_num,ctx,46,0,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 53 ;
 aux_cmp_num += 1;
@@ -6635,27 +6522,14 @@ aux_cmp_num += 1;
 uint aux_create = 4;
 int aux_cmp_num = 0+ctx_index+1;
 uint csoffset = mySignalStart+3178;
-uint aux_dimensions[1] = {208};
 for (uint i = 0; i < 208; i++) {
-std::string new_cmp_name = "decompress"+ctx->generate_position_array(aux_dimensions, 1, i);
-ecDecompress_4_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
+ecDecompress_4_create(csoffset,aux_cmp_num,ctx,47,i,myId);
 mySubcomponents[aux_create+i] = aux_cmp_num;
 csoffset += 782 ;
 aux_cmp_num += 4;
 }
 }
-{
-uint aux_create = 212;
-int aux_cmp_num = 836+ctx_index+1;
-uint csoffset = mySignalStart+166046;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "shuffleEncryptV1";
-ShuffleEncryptTemplate_26_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-csoffset += 958414 ;
-aux_cmp_num += 104318;
-}
-}
+// ShuffleEncryptTemplate_26 created by ShuffleEncryptV2Template_27_create_precomputed
 if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 59. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
 assert(Fr_isTrue(&circuitConstants[2]));
 {
@@ -6728,7 +6602,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 2)]);
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6742,7 +6617,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6756,7 +6632,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 210)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6787,7 +6664,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 54)])
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6801,7 +6679,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[1]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6815,7 +6694,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 262)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6846,7 +6726,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 106)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6860,7 +6741,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[2]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6874,7 +6756,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 314)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6905,7 +6788,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 158)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6919,7 +6803,8 @@ Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[3]].sig
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -6933,7 +6818,8 @@ Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[4])) + 366)]
 }
 // run sub component if needed
 if(!(ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter -= 1)){
-ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
+if (mySubcomponentsParallel[cmp_index_ref]) ctx->runParallel(ctx_index,cmp_index_ref);
+else ecDecompress_4_run(mySubcomponents[cmp_index_ref],ctx);
 
 }
 }
@@ -7070,6 +6956,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 119
 }
+ctx->joinParallel(ctx_index,4,104);
 {
 PFrElement aux_dest = &lvar[4];
 // load src
@@ -7163,6 +7050,7 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 128
 }
+ctx->joinParallel(ctx_index,108,104);
 {
 PFrElement aux_dest = &lvar[4];
 // load src
@@ -7243,27 +7131,42 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 140
 }
-for (uint i = 0; i < 213; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
-}
 }
 
-void ShuffleEncryptV2_28_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
+void ShuffleEncryptV2_28_create(uint soffset,uint coffset,Circom_CalcWit* ctx,uint componentNameId,uint componentPosition,uint componentFather){
 ctx->componentMemory[coffset].templateId = 28;
-ctx->componentMemory[coffset].templateName = "ShuffleEncryptV2";
 ctx->componentMemory[coffset].signalStart = soffset;
 ctx->componentMemory[coffset].inputCounter = 3178;
-ctx->componentMemory[coffset].componentName = componentName;
+ctx->componentMemory[coffset].componentNameId = componentNameId;
+ctx->componentMemory[coffset].componentPosition = componentPosition;
 ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1]{0};
+ctx->componentMemory[coffset].subcomponents = ctx->allocComponentArray<uint>(1);
+}
+
+// Creates the ShuffleEncryptV2Template_27 of ShuffleEncryptV2_28 and the
+// components under it that precompute() needs.
+void ShuffleEncryptV2_28_create_precomputed(uint ctx_index,Circom_CalcWit* ctx){
+u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
+u64 myId = ctx_index;
+u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+{
+uint aux_create = 0;
+int aux_cmp_num = 0+ctx_index+1;
+uint csoffset = mySignalStart+3179;
+for (uint i = 0; i < 1; i++) {
+ShuffleEncryptV2Template_27_create(csoffset,aux_cmp_num,ctx,49,0,myId);
+ShuffleEncryptV2Template_27_create_precomputed(aux_cmp_num,ctx);
+mySubcomponents[aux_create+i] = aux_cmp_num;
+csoffset += 1124460 ;
+aux_cmp_num += 105155;
+}
+}
 }
 
 void ShuffleEncryptV2_28_run(uint ctx_index,Circom_CalcWit* ctx){
 FrElement* signalValues = ctx->signalValues;
 u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
+const char* myTemplateName = templateNames[28];
 u64 myFather = ctx->componentMemory[ctx_index].idFather;
 u64 myId = ctx_index;
 u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
@@ -7280,18 +7183,7 @@ PFrElement aux_dest = &lvar[0];
 // end load src
 Fr_copy(aux_dest,&circuitConstants[0]);
 }
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3179;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "shuffle_encrypt";
-ShuffleEncryptV2Template_27_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-csoffset += 1124460 ;
-aux_cmp_num += 105155;
-}
-}
+// ShuffleEncryptV2Template_27 created by ShuffleEncryptV2_28_create_precomputed
 {
 PFrElement aux_dest = &lvar[1];
 // load src
@@ -7593,14 +7485,66 @@ Fr_copy(aux_dest,&expaux[0]);
 }
 Fr_lt(&expaux[0],&lvar[4],&circuitConstants[0]); // line circom 52
 }
-for (uint i = 0; i < 1; i++){
-uint index_subc = ctx->componentMemory[ctx_index].subcomponents[i];
-if (index_subc != 0)release_memory_component(ctx,index_subc);
 }
+
+// The main component and the ones on the way to what precompute() runs
+// ahead are created before any component runs, so that run() and
+// precompute() create them with the same code. The runs do not create them.
+static void create_precomputed(Circom_CalcWit* ctx){
+ShuffleEncryptV2_28_create(1,0,ctx,0,0,0);
+ShuffleEncryptV2_28_create_precomputed(0,ctx);
 }
 
 void run(Circom_CalcWit* ctx){
-ShuffleEncryptV2_28_create(1,0,ctx,"main",0);
+// already created by precompute()
+if (!ctx->precomputed) create_precomputed(ctx);
 ShuffleEncryptV2_28_run(0,ctx);
 }
 
+bool precompute(Circom_CalcWit* ctx){
+FrElement* signalValues = ctx->signalValues;
+// inputs pk, A and R
+u64 h_pk = fnv1a("pk");
+u64 h_A = fnv1a("A");
+u64 h_R = fnv1a("R");
+if (ctx->findInputSignal(h_pk) < 0 || ctx->findInputSignal(h_A) < 0 || ctx->findInputSignal(h_R) < 0 ||
+    ctx->getInputSignalSize(h_pk) != 2 || ctx->getInputSignalSize(h_A) != 52*52 || ctx->getInputSignalSize(h_R) != 52) {
+throw std::runtime_error("The inputs pk, A and R do not match the ShuffleEncryptTemplate_26 precompute() fills\n");
+}
+u64 pk = ctx->getInputSignalValues(h_pk) - signalValues;
+u64 A = ctx->getInputSignalValues(h_A) - signalValues;
+u64 R = ctx->getInputSignalValues(h_R) - signalValues;
+for (uint i = 0; i < 2; i++) if (!ctx->isInputSignalAssigned(pk + i)) return false;
+for (uint i = 0; i < 52*52; i++) if (!ctx->isInputSignalAssigned(A + i)) return false;
+for (uint i = 0; i < 52; i++) if (!ctx->isInputSignalAssigned(R + i)) return false;
+create_precomputed(ctx);
+uint ctx_index = ctx->precomputedComponent;
+if (ctx->componentMemory[ctx_index].templateId != 26) {
+throw std::runtime_error("The component to precompute is not a ShuffleEncryptTemplate_26\n");
+}
+u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
+for (uint i = 0; i < 52; i++) {
+uint sub = mySubcomponents[i+5];
+u64 subSignalStart = ctx->componentMemory[sub].signalStart;
+// r <== R[i], pk <== pk as in ShuffleEncryptTemplate_26_run
+Fr_copy(&signalValues[subSignalStart + 8],&signalValues[R + i]);
+Fr_copy(&signalValues[subSignalStart + 9],&signalValues[pk]);
+Fr_copy(&signalValues[subSignalStart + 10],&signalValues[pk + 1]);
+if (ctx->pool != NULL) {
+ctx->componentMemory[sub].hasRun = false;
+ctx->pool->push({ElGamalEncrypt_25_run_precompute_parallel, sub, ctx});
+} else {
+ElGamalEncrypt_25_run_precompute(sub,ctx);
+ctx->componentMemory[sub].hasRun = true;
+}
+}
+// A <== A while the ElGamalEncrypt_25 run on the pool
+u64 subSignalStart = ctx->componentMemory[mySubcomponents[0]].signalStart;
+Fr_copyn(&signalValues[subSignalStart],&signalValues[A],52*52);
+ctx->componentMemory[mySubcomponents[0]].inputCounter = 0;
+Permutation_6_run(mySubcomponents[0],ctx);
+ctx->joinParallel(ctx_index,5,52);
+ctx->precomputed = true;
+return true;
+}
+
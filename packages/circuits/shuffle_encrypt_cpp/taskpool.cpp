@@ -0,0 +1,124 @@
+#include "taskpool.hpp"
+
+// Pool and deque of the worker running on this thread, if any.
+static thread_local Circom_TaskPool *currentPool = NULL;
+static thread_local uint currentQueue = 0;
+
+// Times helpUntil finds nothing to run before it sleeps.
+static const uint helpSpins = 64;
+
+Circom_TaskPool::Circom_TaskPool(uint nThreads) {
+  nQueues = nThreads > 0 ? nThreads : 1;
+  queues = new Queue[nQueues];
+  queued = 0;
+  waiting = 0;
+  stopping = false;
+  for (uint q = 1; q < nQueues; q++) {
+    workers.push_back(std::thread(&Circom_TaskPool::workerLoop, this, q));
+  }
+}
+
+Circom_TaskPool::~Circom_TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  sleepCv.notify_all();
+  for (uint i = 0; i < workers.size(); i++) {
+    workers[i].join();
+  }
+  delete [] queues;
+}
+
+uint Circom_TaskPool::myQueue() {
+  return currentPool == this ? currentQueue : 0;
+}
+
+void Circom_TaskPool::push(Circom_Task const &task) {
+  Queue &queue = queues[myQueue()];
+  {
+    // counted under the lock, so a thief never takes it before it counts
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+    queued++;
+  }
+  // taken under sleepMutex so a worker cannot miss it between checking
+  // queued and going to sleep
+  std::lock_guard<std::mutex> lock(sleepMutex);
+  sleepCv.notify_one();
+}
+
+// Pops the newest task of queue q or else steals the oldest task of another
+// queue.
+bool Circom_TaskPool::popTask(uint q, Circom_Task &task) {
+  if (queued == 0) return false;
+  {
+    Queue &queue = queues[q];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      queued--;
+      return true;
+    }
+  }
+  for (uint i = 1; i < nQueues; i++) {
+    Queue &victim = queues[(q + i) % nQueues];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      queued--;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Runs task and wakes the threads sleeping in helpUntil, which may wait for
+// it. Their done flag is set by task.run, and is read by them after they
+// count themselves in waiting, so one side always sees the other.
+void Circom_TaskPool::runTask(Circom_Task const &task) {
+  task.run(task.cIdx, task.ctx);
+  if (waiting > 0) {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    sleepCv.notify_all();
+  }
+}
+
+void Circom_TaskPool::workerLoop(uint q) {
+  currentPool = this;
+  currentQueue = q;
+  Circom_Task task;
+  for (;;) {
+    if (popTask(q, task)) {
+      runTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleepCv.wait(lock, [this] { return stopping || queued > 0; });
+    if (stopping) return;
+  }
+}
+
+void Circom_TaskPool::helpUntil(std::atomic<bool> const &done) {
+  uint q = myQueue();
+  Circom_Task task;
+  uint spins = 0;
+  while (!done) {
+    if (popTask(q, task)) {
+      runTask(task);
+      spins = 0;
+    } else if (++spins < helpSpins) {
+      std::this_thread::yield();
+    } else {
+      // the task it waits for runs elsewhere, sleep until it or a new task
+      // is done or queued
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      waiting++;
+      sleepCv.wait(lock, [this, &done] { return done || queued > 0; });
+      waiting--;
+      spins = 0;
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#ifndef CIRCOM_TASKPOOL_H
+#define CIRCOM_TASKPOOL_H
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "circom.hpp"
+
+class Circom_CalcWit;
+
+struct Circom_Task {
+  void (*run)(uint cIdx, Circom_CalcWit *ctx);
+  uint cIdx;
+  Circom_CalcWit *ctx;
+};
+
+// Work-stealing pool that runs component *_run functions as tasks. Every
+// thread has its own deque: it pushes and pops tasks at the back and, when
+// it runs out of work, steals from the front of the other deques. The thread
+// that owns the pool (the one running the main component) uses deque 0 and
+// helps running tasks while it waits for them, so nThreads counts it too.
+class Circom_TaskPool {
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Circom_Task> tasks;
+  };
+
+  uint nQueues;
+  Queue *queues;
+  std::vector<std::thread> workers;
+
+  std::atomic<uint> queued;
+  std::atomic<uint> waiting; // threads sleeping in helpUntil
+  std::mutex sleepMutex;
+  std::condition_variable sleepCv;
+  bool stopping;
+
+  uint myQueue();
+  bool popTask(uint q, Circom_Task &task);
+  void workerLoop(uint q);
+  void runTask(Circom_Task const &task);
+
+public:
+
+  Circom_TaskPool(uint nThreads);
+  ~Circom_TaskPool();
+
+  void push(Circom_Task const &task);
+
+  // Runs queued tasks on the calling thread until done becomes true.
+  void helpUntil(std::atomic<bool> const &done);
+
+};
+
+#endif // CIRCOM_TASKPOOL_H
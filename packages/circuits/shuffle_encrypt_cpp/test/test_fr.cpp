@@ -0,0 +1,411 @@
+#include <iostream>
+#include <vector>
+#include <string.h>
+
+#include "fr.hpp"
+
+/*
+Checks the field arithmetic of every backend built in against GMP and the
+backends against each other: test_fr. Every operation is run on 0, 1, q-1
+and pseudo random elements.
+*/
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond "\n"; \
+      failures++; \
+    } \
+  } while (0)
+
+static mpz_t q, R, Rinv;
+
+static void toMpz(mpz_t r, const FrRawElement a) {
+  mpz_import(r, Fr_N64, -1, 8, 0, 0, a);
+}
+
+static bool isEqual(const FrRawElement a, mpz_t const e) {
+  FrRawElement v = {0, 0, 0, 0};
+  mpz_export(v, NULL, -1, 8, 0, 0, e);
+  return memcmp(a, v, sizeof(FrRawElement)) == 0;
+}
+
+// 0, 1, q-1 and random elements below q.
+static std::vector<std::vector<uint64_t>> testValues() {
+  std::vector<std::vector<uint64_t>> values;
+  values.push_back({0, 0, 0, 0});
+  values.push_back({1, 0, 0, 0});
+  std::vector<uint64_t> qm1(Fr_rawq, Fr_rawq + Fr_N64);
+  qm1[0]--;
+  values.push_back(qm1);
+  uint64_t x = 0x9E3779B97F4A7C15ull;
+  while (values.size() < 64) {
+    std::vector<uint64_t> v(Fr_N64);
+    for (int j = 0; j < Fr_N64; j++) {
+      x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+      v[j] = x;
+    }
+    v[Fr_N64-1] &= Fr_rawq[Fr_N64-1] >> 1;
+    values.push_back(v);
+  }
+  return values;
+}
+
+static void testRaw() {
+  std::vector<std::vector<uint64_t>> values = testValues();
+  mpz_t a, b, e;
+  mpz_inits(a, b, e, NULL);
+  for (size_t i = 0; i < values.size(); i++) {
+    const uint64_t *ra = values[i].data();
+    toMpz(a, ra);
+    FrRawElement r;
+
+    Fr_rawNeg(r, ra);
+    mpz_neg(e, a);
+    mpz_mod(e, e, q);
+    CHECK(isEqual(r, e));
+
+    Fr_rawMSquare(r, ra);
+    mpz_mul(e, a, a);
+    mpz_mul(e, e, Rinv);
+    mpz_mod(e, e, q);
+    CHECK(isEqual(r, e));
+
+    FrRawElement va;
+    memcpy(va, ra, sizeof(FrRawElement));
+    Fr_rawToMontgomery(r, va);
+    mpz_mul(e, a, R);
+    mpz_mod(e, e, q);
+    CHECK(isEqual(r, e));
+    Fr_rawFromMontgomery(r, r);
+    CHECK(isEqual(r, a));
+
+    for (size_t j = 0; j < values.size(); j++) {
+      const uint64_t *rb = values[j].data();
+      toMpz(b, rb);
+
+      Fr_rawAdd(r, ra, rb);
+      mpz_add(e, a, b);
+      mpz_mod(e, e, q);
+      CHECK(isEqual(r, e));
+
+      Fr_rawSub(r, ra, rb);
+      mpz_sub(e, a, b);
+      mpz_mod(e, e, q);
+      CHECK(isEqual(r, e));
+
+      Fr_rawMMul(r, ra, rb);
+      mpz_mul(e, a, b);
+      mpz_mul(e, e, Rinv);
+      mpz_mod(e, e, q);
+      CHECK(isEqual(r, e));
+
+      Fr_rawMMul1(r, ra, rb[0]);
+      mpz_mul_ui(e, a, rb[0]);
+      mpz_mul(e, e, Rinv);
+      mpz_mod(e, e, q);
+      CHECK(isEqual(r, e));
+    }
+  }
+  mpz_clears(a, b, e, NULL);
+}
+
+// Short, long normal and long Montgomery elements, 0, -1 and q-1 included.
+static std::vector<FrElement> testElements() {
+  std::vector<FrElement> elements;
+  int32_t shorts[] = {0, 1, -1, 5, 253, INT32_MAX, INT32_MIN + 1};
+  for (size_t i = 0; i < sizeof(shorts)/sizeof(shorts[0]); i++) {
+    FrElement e = {shorts[i], Fr_SHORT, {0, 0, 0, 0}};
+    elements.push_back(e);
+  }
+  std::vector<std::vector<uint64_t>> values = testValues();
+  for (size_t i = 0; i < 8; i++) {
+    FrElement e = {0, Fr_LONG, {0, 0, 0, 0}};
+    memcpy(e.longVal, values[i].data(), sizeof(FrRawElement));
+    elements.push_back(e);
+  }
+  size_t n = elements.size();
+  for (size_t i = 0; i < n; i += 2) {
+    FrElement m;
+    Fr_toMontgomery(&m, &elements[i]);
+    elements.push_back(m);
+  }
+  return elements;
+}
+
+static void appendValue(std::vector<uint64_t> &out, PFrElement a) {
+  FrElement v;
+  Fr_toLongNormal(&v, a);
+  FrRawElement raw;
+  memcpy(raw, v.longVal, sizeof(FrRawElement));
+  out.insert(out.end(), raw, raw + Fr_N64);
+}
+
+// Values of all the element operations on every pair of testElements().
+static std::vector<uint64_t> elementResults() {
+  typedef void (*BinaryOp)(PFrElement, PFrElement, PFrElement);
+  typedef void (*UnaryOp)(PFrElement, PFrElement);
+  BinaryOp binary[] = {Fr_add, Fr_sub, Fr_mul, Fr_band, Fr_bor, Fr_bxor, Fr_shl, Fr_shr,
+    Fr_eq, Fr_neq, Fr_lt, Fr_gt, Fr_leq, Fr_geq, Fr_land, Fr_lor};
+  UnaryOp unary[] = {Fr_copy, Fr_neg, Fr_square, Fr_bnot, Fr_lnot, Fr_toNormal, Fr_toLongNormal, Fr_toMontgomery};
+  std::vector<FrElement> elements = testElements();
+  std::vector<uint64_t> out;
+  FrElement r;
+  for (size_t i = 0; i < elements.size(); i++) {
+    PFrElement a = &elements[i];
+    for (size_t k = 0; k < sizeof(unary)/sizeof(unary[0]); k++) {
+      unary[k](&r, a);
+      appendValue(out, &r);
+    }
+    out.push_back(Fr_isTrue(a));
+    for (size_t j = 0; j < elements.size(); j++) {
+      for (size_t k = 0; k < sizeof(binary)/sizeof(binary[0]); k++) {
+        binary[k](&r, a, &elements[j]);
+        appendValue(out, &r);
+      }
+    }
+  }
+  return out;
+}
+
+static void testInv() {
+  std::vector<std::vector<uint64_t>> values = testValues();
+  mpz_t a, e;
+  mpz_inits(a, e, NULL);
+  for (size_t i = 0; i < values.size(); i++) {
+    FrRawElement r;
+    Fr_rawInv(r, values[i].data());
+    toMpz(a, values[i].data());
+    if (mpz_sgn(a) == 0) {
+      mpz_set_ui(e, 0);
+    } else {
+      mpz_invert(e, a, q);
+    }
+    CHECK(isEqual(r, e));
+  }
+  mpz_clears(a, e, NULL);
+
+  // Fr_inv keeps the form of its input, a * a^-1 = 1 and 0^-1 = 0
+  std::vector<FrElement> elements = testElements();
+  FrElement one = {1, Fr_SHORT, {0, 0, 0, 0}};
+  for (size_t i = 0; i < elements.size(); i++) {
+    FrElement inv, product, isOne;
+    Fr_inv(&inv, &elements[i]);
+    CHECK(inv.type == ((elements[i].type & Fr_LONGMONTGOMERY) == Fr_LONGMONTGOMERY ? Fr_LONGMONTGOMERY : Fr_LONG));
+    Fr_mul(&product, &elements[i], &inv);
+    Fr_eq(&isOne, &product, &one);
+    CHECK(Fr_isTrue(&elements[i]) ? Fr_isTrue(&isOne) : !Fr_isTrue(&inv));
+  }
+}
+
+static bool fromDigits(FrRawElement r, std::string const &s, uint base) {
+  return Fr_rawFromDigits(r, s.data(), s.size(), base);
+}
+
+static void testDigits() {
+  std::vector<std::vector<uint64_t>> values = testValues();
+  uint bases[] = {2, 8, 10, 16, 36};
+  mpz_t a, e;
+  mpz_inits(a, e, NULL);
+  for (size_t i = 0; i < values.size(); i++) {
+    toMpz(a, values[i].data());
+    for (size_t b = 0; b < sizeof(bases)/sizeof(bases[0]); b++) {
+      char s[Fr_N64*64 + 1];
+      size_t n = Fr_rawToDigits(s, values[i].data(), bases[b]);
+      char *expected = mpz_get_str(NULL, bases[b], a);
+      CHECK(n == strlen(s) && strcmp(s, expected) == 0);
+      free(expected);
+      FrRawElement r;
+      CHECK(fromDigits(r, s, bases[b]) && isEqual(r, a));
+    }
+  }
+
+  // leading zeros, upper case and values reduced mod q
+  FrRawElement r;
+  CHECK(fromDigits(r, "0", 10) && Fr_rawIsZero(r));
+  CHECK(fromDigits(r, "000123", 10) && r[0] == 123 && r[1] == 0 && r[2] == 0 && r[3] == 0);
+  CHECK(fromDigits(r, "FF", 16) && r[0] == 255);
+  const char *large[] = {
+    "21888242871839275222246405745257275088548364400416034343698204186575808495617", // q
+    "21888242871839275222246405745257275088548364400416034343698204186575808495622", // q+5
+    "115792089237316195423570985008687907853269984665640564039457584007913129639935", // 2^256-1
+    "1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890"};
+  for (size_t i = 0; i < sizeof(large)/sizeof(large[0]); i++) {
+    mpz_set_str(e, large[i], 10);
+    mpz_mod(e, e, q);
+    CHECK(fromDigits(r, large[i], 10) && isEqual(r, e));
+  }
+  mpz_clears(a, e, NULL);
+
+  CHECK(!fromDigits(r, "", 10));
+  CHECK(!fromDigits(r, "12a", 10));
+  CHECK(!fromDigits(r, "-1", 10));
+  CHECK(!fromDigits(r, "102", 2));
+  CHECK(!fromDigits(r, "1", 1));
+  CHECK(!fromDigits(r, "1", 37));
+}
+
+// Fr_toBits of a with n bits against GMP.
+static void checkToBits(PFrElement a, int n) {
+  FrElement v;
+  Fr_toLongNormal(&v, a);
+  FrRawElement raw;
+  memcpy(raw, v.longVal, sizeof(FrRawElement));
+  mpz_t e;
+  mpz_init(e);
+  toMpz(e, raw);
+  std::vector<FrElement> bits(n + 1);
+  bool fits = Fr_toBits(bits.data(), a, n);
+  CHECK(fits == (mpz_sizeinbase(e, 2) <= (size_t)n || mpz_sgn(e) == 0));
+  bool same = true;
+  for (int i = 0; i < n; i++) {
+    same = same && bits[i].type == Fr_SHORT && bits[i].shortVal == mpz_tstbit(e, i);
+  }
+  CHECK(same);
+  mpz_clear(e);
+}
+
+// Fr_toBits at the boundary: 2^k-1 and 2^k with k and k+1 bits, and q-1
+// around 254 bits, in every form.
+static void testToBits() {
+  std::vector<FrElement> elements = testElements();
+  int widths[] = {0, 1, 31, 32, 63, 64, 253, 254, 256, 300};
+  for (size_t i = 0; i < elements.size(); i++) {
+    for (size_t w = 0; w < sizeof(widths)/sizeof(widths[0]); w++) {
+      checkToBits(&elements[i], widths[w]);
+    }
+  }
+  int powers[] = {1, 31, 32, 63, 64, 128, 253};
+  for (size_t p = 0; p < sizeof(powers)/sizeof(powers[0]); p++) {
+    int k = powers[p];
+    FrElement pow = {0, Fr_LONG, {0, 0, 0, 0}};
+    pow.longVal[k / 64] = 1ull << (k % 64);
+    FrElement one = {1, Fr_SHORT, {0, 0, 0, 0}};
+    FrElement below;
+    Fr_sub(&below, &pow, &one);
+    FrElement forms[4] = {pow, below};
+    Fr_toMontgomery(&forms[2], &pow);
+    Fr_toMontgomery(&forms[3], &below);
+    for (int f = 0; f < 4; f++) {
+      checkToBits(&forms[f], k);
+      checkToBits(&forms[f], k + 1);
+    }
+  }
+}
+
+// Fr_batchInv gives the values of Fr_inv, with zeros first, last, in the
+// middle, in a row and everywhere.
+static void testBatchInv() {
+  std::vector<FrElement> elements = testElements();
+  FrElement zero = {0, Fr_SHORT, {0, 0, 0, 0}};
+  std::vector<std::vector<FrElement>> batches;
+  batches.push_back(std::vector<FrElement>());
+  batches.push_back(std::vector<FrElement>(1, zero));
+  batches.push_back(std::vector<FrElement>(3, zero));
+  batches.push_back(std::vector<FrElement>(1, elements[1]));
+  std::vector<FrElement> mixed;
+  mixed.push_back(zero);
+  for (size_t i = 1; i < elements.size(); i++) {
+    mixed.push_back(elements[i]);
+    if (i % 5 == 0) mixed.push_back(zero);
+    if (i == 9) mixed.push_back(zero);
+  }
+  mixed.push_back(zero);
+  batches.push_back(mixed);
+  batches.push_back(elements);
+
+  for (size_t b = 0; b < batches.size(); b++) {
+    std::vector<FrElement> &in = batches[b];
+    int n = in.size();
+    std::vector<FrElement> out(n + 1);
+    Fr_batchInv(out.data(), in.data(), n);
+    for (int i = 0; i < n; i++) {
+      FrElement inv, same;
+      Fr_inv(&inv, &in[i]);
+      Fr_eq(&same, &out[i], &inv);
+      CHECK(Fr_isTrue(&same));
+    }
+  }
+}
+
+// The bulk conversions against the scalar ones, for lengths around the
+// 8 element batches.
+static void testBulk() {
+  std::vector<FrElement> elements = testElements();
+  std::vector<FrElement> montgomery;
+  for (size_t i = 0; i < elements.size(); i++) {
+    FrElement m;
+    Fr_toMontgomery(&m, &elements[i]);
+    montgomery.push_back(m);
+  }
+  uint lengths[] = {0, 1, 7, 8, 9, 17};
+  for (size_t l = 0; l < sizeof(lengths)/sizeof(lengths[0]); l++) {
+    uint n = lengths[l];
+    std::vector<uint64_t> index(n);
+    for (uint i = 0; i < n; i++) index[i] = (i * 7 + 3) % elements.size();
+
+    std::vector<uint8_t> normal(n*Fr_N64*8 + 1), mont(n*Fr_N64*8 + 1);
+    // r need not be aligned
+    Fr_toLongNormal_n(normal.data() + 1, elements.data(), index.data(), n);
+    Fr_toLongMontgomery_n(mont.data() + 1, elements.data(), index.data(), n);
+    FrRawElement raw[17], fromMont[17];
+    for (uint i = 0; i < n; i++) {
+      memcpy(raw[i], montgomery[index[i]].longVal, sizeof(FrRawElement));
+    }
+    Fr_rawFromMontgomery_n(fromMont, raw, n);
+    for (uint i = 0; i < n; i++) {
+      FrElement v, m;
+      Fr_toLongNormal(&v, &elements[index[i]]);
+      Fr_toMontgomery(&m, &elements[index[i]]);
+      CHECK(memcmp(normal.data() + 1 + i*Fr_N64*8, v.longVal, Fr_N64*8) == 0);
+      CHECK(memcmp(mont.data() + 1 + i*Fr_N64*8, m.longVal, Fr_N64*8) == 0);
+      CHECK(memcmp(fromMont[i], v.longVal, Fr_N64*8) == 0);
+    }
+
+    // without index, a[i]
+    std::vector<FrElement> selected(n);
+    for (uint i = 0; i < n; i++) selected[i] = montgomery[index[i]];
+    std::vector<uint8_t> direct(n*Fr_N64*8);
+    Fr_toLongNormal_n(direct.data(), selected.data(), NULL, n);
+    CHECK(memcmp(direct.data(), normal.data() + 1, n*Fr_N64*8) == 0);
+  }
+}
+
+int main() {
+  mpz_inits(q, R, Rinv, NULL);
+  toMpz(q, Fr_rawq);
+  mpz_setbit(R, Fr_N64*64);
+  mpz_invert(Rinv, R, q);
+  mpz_mod(R, R, q);
+
+  const char *backends[] = {"generic", "asm"};
+  std::vector<uint64_t> first;
+  for (size_t i = 0; i < sizeof(backends)/sizeof(backends[0]); i++) {
+    if (!Fr_setBackend(backends[i])) {
+      std::cout << "test_fr: backend " << backends[i] << " not available\n";
+      continue;
+    }
+    testRaw();
+    testInv();
+    testDigits();
+    testToBits();
+    testBatchInv();
+    testBulk();
+    std::vector<uint64_t> results = elementResults();
+    if (first.empty()) {
+      first = results;
+    } else {
+      CHECK(results == first);
+    }
+  }
+
+  mpz_clears(q, R, Rinv, NULL);
+  if (failures) {
+    std::cerr << failures << " checks failed\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "test_fr: all checks passed\n";
+  return EXIT_SUCCESS;
+}
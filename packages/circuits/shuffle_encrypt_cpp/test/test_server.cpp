@@ -0,0 +1,129 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+Checks that a bad request gets an error frame and leaves the server up:
+test_server <shuffle_encrypt> <input.json> starts the server mode of the
+binary and sends a request with an unknown key, one with a repeated key and
+the valid input on the same connection.
+*/
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond "\n"; \
+      failures++; \
+    } \
+  } while (0)
+
+static bool readFull(int fd, void *buf, size_t n) {
+  uint8_t *p = (uint8_t *)buf;
+  while (n > 0) {
+    ssize_t r = read(fd, p, n);
+    if (r <= 0) return false;
+    p += r;
+    n -= r;
+  }
+  return true;
+}
+
+static bool writeFull(int fd, const void *buf, size_t n) {
+  const uint8_t *p = (const uint8_t *)buf;
+  while (n > 0) {
+    ssize_t r = write(fd, p, n);
+    if (r <= 0) return false;
+    p += r;
+    n -= r;
+  }
+  return true;
+}
+
+// Sends input and reads the response frame. Returns false if the
+// connection broke.
+static bool request(int fd, std::string const &input, uint32_t &status, std::string &response) {
+  uint64_t len = input.size();
+  if (!writeFull(fd, &len, sizeof(len)) || !writeFull(fd, input.data(), len)) return false;
+  if (!readFull(fd, &status, sizeof(status)) || !readFull(fd, &len, sizeof(len))) return false;
+  response.resize(len);
+  return len == 0 || readFull(fd, &response[0], len);
+}
+
+static int connectTo(std::string const &socketPath) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+  // the server needs a moment to load the circuit
+  for (int i = 0; i < 600; i++) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) return fd;
+    close(fd);
+    usleep(100000);
+  }
+  return -1;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <shuffle_encrypt> <input.json>\n";
+    return EXIT_FAILURE;
+  }
+  std::ifstream inStream(argv[2]);
+  std::stringstream buf;
+  buf << inStream.rdbuf();
+  std::string input = buf.str();
+
+  std::string socketPath = "/tmp/test_server_" + std::to_string(getpid()) + ".sock";
+  pid_t server = fork();
+  if (server == 0) {
+    execl(argv[1], argv[1], "--server", socketPath.c_str(), "1", (char *)NULL);
+    perror("execl");
+    _exit(EXIT_FAILURE);
+  }
+
+  int fd = connectTo(socketPath);
+  CHECK(fd != -1);
+  if (fd != -1) {
+    uint32_t status;
+    std::string response;
+
+    std::string unknown = "{\"pkk\":[\"1\",\"2\"]," + input.substr(input.find('{') + 1);
+    CHECK(request(fd, unknown, status, response));
+    CHECK(status == 1);
+    CHECK(response.find("Unknown input signal pkk") != std::string::npos);
+
+    size_t pk = input.find("\"pk\"");
+    std::string pkValue = input.substr(pk, input.find(']', pk) + 1 - pk);
+    std::string twice = "{" + pkValue + "," + input.substr(input.find('{') + 1);
+    CHECK(request(fd, twice, status, response));
+    CHECK(status == 1);
+    CHECK(response.find("given twice") != std::string::npos);
+
+    CHECK(request(fd, input, status, response));
+    CHECK(status == 0);
+    CHECK(response.compare(0, 4, "wtns") == 0);
+    close(fd);
+  }
+
+  kill(server, SIGTERM);
+  waitpid(server, NULL, 0);
+  unlink(socketPath.c_str());
+  if (failures) {
+    std::cerr << failures << " checks failed\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "test_server: all checks passed\n";
+  return EXIT_SUCCESS;
+}
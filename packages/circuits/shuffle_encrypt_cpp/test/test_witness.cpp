@@ -0,0 +1,230 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+#include "witness.hpp"
+
+using json = nlohmann::json;
+
+/*
+Checks the witness API on the circuit: test_witness <circuit.dat> <input.json>
+<input.wtns> with a valid input and its witness, written by the original
+generated code (test/input.wtns.gz). Every other input is derived from it.
+*/
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond "\n"; \
+      failures++; \
+    } \
+  } while (0)
+
+// Message of the std::runtime_error thrown by f, "" if it returns.
+template <class F>
+static std::string errorOf(F f) {
+  try {
+    f();
+  } catch (std::runtime_error &e) {
+    return e.what();
+  }
+  return "";
+}
+
+static bool contains(std::string const &s, std::string const &part) {
+  return s.find(part) != std::string::npos;
+}
+
+static void testInputKeys(Circom_CalcWit *ctx, json const &input, std::string const &wtns) {
+  json unknown = input;
+  unknown["pkk"] = unknown["pk"];
+  std::string w;
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, unknown.dump(), w); }), "Unknown input signal pkk"));
+
+  // json objects cannot repeat a key, write the text
+  std::string text = input.dump();
+  std::string twice = "{\"pk\":" + input["pk"].dump() + "," + text.substr(1);
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, twice, w); }), "Input signal pk given twice"));
+
+  // the context is still usable
+  CHECK(errorOf([&]{ calcWitness(ctx, text, w); }) == "");
+  CHECK(w == wtns);
+}
+
+static void testInputValues(Circom_CalcWit *ctx, json const &input) {
+  const char *invalid[] = {"", "0x", "12a", "-"};
+  for (size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); i++) {
+    json bad = input;
+    bad["pk"][0] = invalid[i];
+    std::string w;
+    CHECK(contains(errorOf([&]{ calcWitness(ctx, bad.dump(), w); }), "Invalid number in JSON input"));
+  }
+}
+
+// A given as {"permutation": [...]} gives the witness of the full matrix;
+// anything but a permutation of 0..51 is an error.
+static void testPermutation(Circom_CalcWit *ctx, json const &input, std::string const &wtns) {
+  const size_t n = 52;
+  std::vector<u64> p(n);
+  for (size_t k = 0; k < n*n; k++) {
+    if (input["A"][k] == "1") p[k / n] = k % n;
+  }
+  json perm = input;
+  perm["A"] = {{"permutation", p}};
+  std::string w;
+  calcWitness(ctx, perm.dump(), w);
+  CHECK(w == wtns);
+
+  json q = p;
+  q[n-1] = q[0];
+  json invalid = json::array({q}); // repeated index
+  q = p;
+  q[3] = n;
+  invalid.push_back(q); // out of range
+  q = p;
+  q[5] = -1;
+  invalid.push_back(q); // negative
+  for (size_t i = 0; i < invalid.size(); i++) {
+    perm["A"] = {{"permutation", invalid[i]}};
+    CHECK(contains(errorOf([&]{ calcWitness(ctx, perm.dump(), w); }), "Error loading signal A: Not a permutation"));
+  }
+  q = p;
+  q.erase(q.size() - 1);
+  json sizes = json::array({q}); // too short
+  q = p;
+  q.push_back(0);
+  sizes.push_back(q); // too long
+  for (size_t i = 0; i < sizes.size(); i++) {
+    perm["A"] = {{"permutation", sizes[i]}};
+    CHECK(contains(errorOf([&]{ calcWitness(ctx, perm.dump(), w); }), "Error loading signal A: Wrong number of indices"));
+  }
+  perm["A"] = {{"permutation", p}, {"other", 1}};
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, perm.dump(), w); }), "Unknown key in a permutation"));
+  perm["A"] = {{"permutation", -1}};
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, perm.dump(), w); }), "Invalid JSON type"));
+}
+
+static void testBinInput(Circom_CalcWit *ctx, json const &input, std::string const &wtns) {
+  std::string bin, w;
+  json2BinInput(ctx, input.dump(), bin);
+  CHECK(isBinInput(bin));
+  CHECK(bin.size() == sizeof(BinInputHeader) + (size_t)get_main_input_signal_no()*Fr_N64*8);
+  calcWitness(ctx, bin, w);
+  CHECK(w == wtns);
+
+  json partial = input;
+  partial.erase("R");
+  CHECK(contains(errorOf([&]{ json2BinInput(ctx, partial.dump(), w); }), "Not all inputs have been set"));
+
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, bin.substr(0, 10), w); }), "too short"));
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, bin.substr(0, bin.size() - 1), w); }), "wrong number of signals"));
+  std::string other = bin;
+  other[4]++;
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, other, w); }), "unknown format"));
+  other = bin;
+  other[8]++;
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, other, w); }), "made for another circuit"));
+
+  // values must be below q
+  size_t first = sizeof(BinInputHeader);
+  other = bin;
+  memcpy(&other[first], Fr_rawq, Fr_N64*8);
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, other, w); }), "value of signal 2 is not below q"));
+  memset(&other[first], 0xFF, Fr_N64*8);
+  CHECK(contains(errorOf([&]{ calcWitness(ctx, other, w); }), "value of signal 2 is not below q"));
+}
+
+static void testMontgomery(Circom_CalcWit *ctx, json const &input, std::string const &wtns) {
+  std::string m;
+  calcWitness(ctx, input.dump(), m, true);
+  u32 version;
+  memcpy(&version, m.data() + 4, 4);
+  CHECK(version == WTNS_MONTGOMERY_VERSION);
+
+  const size_t n8 = Fr_N64*8;
+  CHECK(m.size() == wtns.size() + n8);
+  size_t data = getBinWitnessSize() - (size_t)get_size_of_witness()*n8;
+  bool same = true;
+  for (uint i = 0; i < get_size_of_witness() && same; i++) {
+    FrElement v = {0, Fr_LONG, {0, 0, 0, 0}};
+    memcpy(v.longVal, wtns.data() + data + i*n8, n8);
+    Fr_toMontgomery(&v, &v);
+    same = memcmp(v.longVal, m.data() + data + n8 + i*n8, n8) == 0;
+  }
+  CHECK(same);
+}
+
+// precomputeWitness with pk, A and R, then calcWitnessOnline with the rest
+// gives the one-shot witness, on one thread and on the pool.
+static void testPrecompute(Circom_Circuit *circuit, json const &input, std::string const &wtns) {
+  json offline, online;
+  for (auto it = input.begin(); it != input.end(); ++it) {
+    bool known = it.key() == "pk" || it.key() == "A" || it.key() == "R";
+    (known ? offline : online)[it.key()] = it.value();
+  }
+  uint threads[] = {1, 3};
+  for (uint t = 0; t < 2; t++) {
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit, threads[t]);
+    for (int k = 0; k < 2; k++) {
+      std::string w;
+      precomputeWitness(ctx, offline.dump());
+      calcWitnessOnline(ctx, online.dump(), w);
+      CHECK(w == wtns);
+    }
+    std::string w;
+    CHECK(contains(errorOf([&]{ calcWitnessOnline(ctx, online.dump(), w); }), "has not been precomputed"));
+
+    json partial = offline;
+    partial.erase("R");
+    CHECK(contains(errorOf([&]{ precomputeWitness(ctx, partial.dump()); }), "Not all the inputs needed"));
+    CHECK(contains(errorOf([&]{ precomputeWitness(ctx, input.dump()); }), "nothing is left to compute online"));
+    delete ctx;
+  }
+}
+
+// The witness is normalized in chunks on the pool of a threaded context.
+static void testThreads(Circom_Circuit *circuit, json const &input, std::string const &wtns) {
+  Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 3);
+  std::string w;
+  calcWitness(ctx, input.dump(), w);
+  CHECK(w == wtns);
+  delete ctx;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " <circuit.dat> <input.json> <input.wtns>\n";
+    return EXIT_FAILURE;
+  }
+  Circom_Circuit *circuit = loadCircuit(argv[1]);
+  std::ifstream inStream(argv[2]);
+  json input = json::parse(inStream);
+
+  Circom_CalcWit *ctx = new Circom_CalcWit(circuit, 1);
+  std::string wtns;
+  calcWitness(ctx, input.dump(), wtns);
+  std::ifstream expectedStream(argv[3], std::ios::binary);
+  std::stringstream expected;
+  expected << expectedStream.rdbuf();
+  CHECK(expectedStream && wtns == expected.str());
+
+  testInputKeys(ctx, input, wtns);
+  testInputValues(ctx, input);
+  testPermutation(ctx, input, wtns);
+  testBinInput(ctx, input, wtns);
+  testMontgomery(ctx, input, wtns);
+  testThreads(circuit, input, wtns);
+  testPrecompute(circuit, input, wtns);
+
+  delete ctx;
+  freeCircuit(circuit);
+  if (failures) {
+    std::cerr << failures << " checks failed\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "test_witness: all checks passed\n";
+  return EXIT_SUCCESS;
+}
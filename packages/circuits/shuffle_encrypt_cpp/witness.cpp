@@ -0,0 +1,582 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <nlohmann/json.hpp>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+using json = nlohmann::json;
+
+#include "witness.hpp"
+
+
+Circom_Circuit* loadCircuit(std::string const &datFileName) {
+    Circom_Circuit *circuit = new Circom_Circuit;
+
+    int fd;
+    struct stat sb;
+
+    fd = open(datFileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cout << ".dat file not found: " << datFileName << "\n";
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+    
+    if (fstat(fd, &sb) == -1) {          /* To obtain file size */
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+
+    // The mapping is kept for the life of the circuit: the tables below point
+    // into it, so only the pages actually used are read and processes loading
+    // the same .dat share them.
+    u8* bdata = (u8*)mmap(NULL, sb.st_size, PROT_READ , MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (bdata == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    circuit->datData = bdata;
+    circuit->datSize = sb.st_size;
+    circuit->InputHashMap = (HashSignalInfo*)bdata;
+    uint dsize = get_size_of_input_hashmap()*sizeof(HashSignalInfo);
+
+    uint inisize = dsize;    
+    circuit->witness2SignalList = (u64*)(bdata+inisize);
+    dsize = get_size_of_witness()*sizeof(u64);
+
+    inisize += dsize;
+    circuit->circuitConstants = (FrElement*)(bdata+inisize);
+    dsize = get_size_of_constants()*sizeof(FrElement);
+
+    // binary inputs are tied to the input layout: the used entries of the
+    // input hash map and the range of the main inputs
+    std::string layout;
+    for (uint i = 0; i < get_size_of_input_hashmap(); i++) {
+      if (circuit->InputHashMap[i].signalid != 0) {
+        layout.append((char *)&circuit->InputHashMap[i], sizeof(HashSignalInfo));
+      }
+    }
+    layout += std::to_string(get_main_input_signal_start()) + "," + std::to_string(get_main_input_signal_no());
+    circuit->inputHash = fnv1a(layout);
+
+    circuit->fixedSignals = new std::atomic<FrElement*>[get_number_of_templates()];
+    for (uint i = 0; i < get_number_of_templates(); i++) {
+      circuit->fixedSignals[i] = NULL;
+    }
+
+    circuit->templateInsId2IOSignalInfo = new IODefPair[get_number_of_templates()]();
+    if (get_size_of_io_map()>0) {
+      inisize += dsize;
+      u32* index = (u32*)(bdata+inisize);
+      dsize = get_size_of_io_map()*sizeof(u32);
+      inisize += dsize;
+      assert(inisize % sizeof(u32) == 0);    
+      assert(sb.st_size % sizeof(u32) == 0);
+      u32* pu32 = (u32*)(bdata+inisize);
+
+      for (uint i = 0; i < get_size_of_io_map(); i++) {
+	u32 n = *pu32;
+	IODefPair p;
+	p.len = n;
+	p.defs = new IODef[n];
+	pu32 += 1;
+	for (u32 j = 0; j <n; j++){
+	  p.defs[j].offset=*pu32;
+	  u32 len = *(pu32+1);
+	  p.defs[j].len = len;
+	  p.defs[j].lengths = pu32+2;
+	  pu32 += len + 2;
+	}
+	assert(index[i] < get_number_of_templates());
+	circuit->templateInsId2IOSignalInfo[index[i]] = p;
+      }
+    }
+    
+    return circuit;
+}
+
+void freeCircuit(Circom_Circuit *circuit) {
+    for (uint i = 0; i < get_number_of_templates(); i++) {
+      delete [] circuit->templateInsId2IOSignalInfo[i].defs;
+      delete [] circuit->fixedSignals[i].load();
+    }
+    delete [] circuit->templateInsId2IOSignalInfo;
+    delete [] circuit->fixedSignals;
+    munmap(circuit->datData, circuit->datSize);
+    delete circuit;
+}
+
+// Same representation as Fr_str2element: short if it fits, else long normal.
+static void raw2element(PFrElement pE, FrRawElement a) {
+  if (a[1] == 0 && a[2] == 0 && a[3] == 0 && a[0] <= 0x7FFFFFFF) {
+    pE->type = Fr_SHORT;
+    pE->shortVal = (int32_t)a[0];
+  } else {
+    pE->type = Fr_LONG;
+    pE->shortVal = 0;
+    memcpy(pE->longVal, a, sizeof(FrRawElement));
+  }
+}
+
+// SAX handler of the JSON input. Every value is converted straight into its
+// input signal slot: the key is resolved once when it is read, unknown or
+// repeated keys and values past the size of the signal are rejected before
+// anything is written. A
+// signal given as {"permutation": [...]} collects the indices and expands
+// them once the object ends.
+class JsonInputLoader : public json::json_sax_t {
+
+  Circom_CalcWit *ctx;
+  uint depth;
+  std::string signalName;
+  u64 signalHash;
+  PFrElement values;
+  u64 signalSize;
+  u64 nValues;
+  std::string parseError;
+  bool inPermutation;
+  std::vector<u64> permutation;
+
+  PFrElement nextValue() {
+    if (depth == 0) {
+      throw std::runtime_error("Invalid JSON input: expected an object of signals\n");
+    }
+    if (nValues == signalSize) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error loading signal " << signalName << ": Too many values\n";
+      throw std::runtime_error(errStrStream.str() );
+    }
+    return &values[nValues++];
+  }
+
+  void endValue() {
+    if (depth > 1) return;
+    if (nValues < signalSize) {
+      std::ostringstream errStrStream;
+      errStrStream << "Error loading signal " << signalName << ": Not enough values\n";
+      throw std::runtime_error(errStrStream.str() );
+    }
+    ctx->setInputSignalAssigned(signalHash);
+  }
+
+  bool invalidType() {
+    throw std::runtime_error("Invalid JSON type\n");
+  }
+
+  void permutationError(const char *reason) {
+    std::ostringstream errStrStream;
+    errStrStream << "Error loading signal " << signalName << ": " << reason << "\n";
+    throw std::runtime_error(errStrStream.str() );
+  }
+
+  void value(FrRawElement v) {
+    if (!inPermutation) {
+      raw2element(nextValue(), v);
+      endValue();
+      return;
+    }
+    if (depth != 3) invalidType();
+    if (v[1] != 0 || v[2] != 0 || v[3] != 0 || permutation.size() == signalSize) {
+      permutationError("Not a permutation");
+    }
+    permutation.push_back(v[0]);
+  }
+
+  // Row i of the n*n matrix is 0 but for a 1 in column permutation[i], as
+  // the permutation matrices of the shuffle. Checked in O(n), the zeros
+  // are written as short values without parsing.
+  void endPermutation() {
+    u64 n = permutation.size();
+    if (n * n != signalSize) {
+      permutationError("Wrong number of indices for a permutation matrix");
+    }
+    std::vector<bool> seen(n, false);
+    for (u64 i = 0; i < n; i++) {
+      if (permutation[i] >= n || seen[permutation[i]]) permutationError("Not a permutation");
+      seen[permutation[i]] = true;
+    }
+    for (u64 k = 0; k < signalSize; k++) {
+      values[k].type = Fr_SHORT;
+      values[k].shortVal = 0;
+    }
+    for (u64 i = 0; i < n; i++) {
+      values[i*n + permutation[i]].shortVal = 1;
+    }
+    nValues = signalSize;
+    ctx->setInputSignalAssigned(signalHash);
+  }
+
+  // Numbers go through a double, as JavaScript would read them.
+  bool number(double vd) {
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(0) << vd;
+    std::string s = stream.str();
+    bool negative = s[0] == '-';
+    FrRawElement v;
+    Fr_rawFromDigits(v, s.c_str() + negative, s.size() - negative, 10);
+    if (negative && !Fr_rawIsZero(v)) Fr_rawNeg(v, v);
+    value(v);
+    return true;
+  }
+
+public:
+
+  JsonInputLoader(Circom_CalcWit *aCtx) : ctx(aCtx), depth(0), inPermutation(false) {}
+
+  std::string const &error() { return parseError; }
+
+  bool null() override { return invalidType(); }
+  bool boolean(bool) override { return invalidType(); }
+  bool binary(binary_t &) override { return invalidType(); }
+  bool number_integer(number_integer_t val) override { return number((double)val); }
+  bool number_unsigned(number_unsigned_t val) override { return number((double)val); }
+  bool number_float(number_float_t val, const string_t &) override { return number(val); }
+
+  bool string(string_t &val) override {
+    const char *s = val.c_str();
+    size_t n = val.size();
+    uint base = 10;
+    if (n >= 2 && s[0] == '0') {
+      switch (s[1]) {
+        case 'b': case 'B': base = 2; break;
+        case 'o': case 'O': base = 8; break;
+        case 'x': case 'X': base = 16; break;
+      }
+      if (base != 10) {
+        s += 2;
+        n -= 2;
+      }
+    }
+    FrRawElement v;
+    if (!Fr_rawFromDigits(v, s, n, base)) {
+      std::ostringstream errStrStream;
+      errStrStream << "Invalid number in JSON input: " << val << "\n";
+      throw std::runtime_error(errStrStream.str() );
+    }
+    value(v);
+    return true;
+  }
+
+  bool start_object(std::size_t) override {
+    if (depth == 1) {
+      inPermutation = true;
+      permutation.clear();
+    } else if (depth > 0) {
+      return invalidType();
+    }
+    depth++;
+    return true;
+  }
+
+  bool end_object() override {
+    depth--;
+    if (inPermutation) {
+      endPermutation();
+      inPermutation = false;
+    }
+    return true;
+  }
+
+  bool key(string_t &val) override {
+    if (inPermutation) {
+      if (val != "permutation") permutationError("Unknown key in a permutation");
+      return true;
+    }
+    signalName = val;
+    signalHash = fnv1a(val);
+    if (ctx->findInputSignal(signalHash) < 0) {
+      throw std::runtime_error("Unknown input signal " + signalName + "\n");
+    }
+    signalSize = ctx->getInputSignalSize(signalHash);
+    values = ctx->getInputSignalValues(signalHash);
+    u64 first = values - ctx->signalValues;
+    for (u64 i = 0; i < signalSize; i++) {
+      if (ctx->isInputSignalAssigned(first + i)) {
+        throw std::runtime_error("Input signal " + signalName + " given twice\n");
+      }
+    }
+    nValues = 0;
+    return true;
+  }
+
+  bool start_array(std::size_t) override {
+    if (depth == 0) {
+      throw std::runtime_error("Invalid JSON input: expected an object of signals\n");
+    }
+    if (inPermutation && depth != 2) return invalidType();
+    depth++;
+    return true;
+  }
+
+  bool end_array() override {
+    depth--;
+    if (!inPermutation) endValue();
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+    parseError = ex.what();
+    return false;
+  }
+};
+
+template <class Input>
+static void loadJsonInput(Circom_CalcWit *ctx, Input &&input, bool run = true) {
+  JsonInputLoader loader(ctx);
+  if (!json::sax_parse(input, &loader)) {
+    throw std::runtime_error(loader.error());
+  }
+  if (run) ctx->tryRunCircuit();
+}
+
+void loadJson(Circom_CalcWit *ctx, std::istream &inStream) {
+  loadJsonInput(ctx, inStream);
+}
+
+void loadJson(Circom_CalcWit *ctx, std::string filename) {
+  std::ifstream inStream(filename);
+  loadJson(ctx, inStream);
+}
+
+bool isBinInput(std::string const &input) {
+  return input.compare(0, 4, BIN_INPUT_MAGIC, 4) == 0;
+}
+
+void loadBinInput(Circom_CalcWit *ctx, std::string const &input) {
+  BinInputHeader header;
+  if (input.size() < sizeof(header)) {
+    throw std::runtime_error("Invalid binary input: too short\n");
+  }
+  memcpy(&header, input.data(), sizeof(header));
+  if (memcmp(header.magic, BIN_INPUT_MAGIC, 4) != 0 || header.version != BIN_INPUT_VERSION) {
+    throw std::runtime_error("Invalid binary input: unknown format\n");
+  }
+  if (header.inputHash != ctx->getInputHash()) {
+    throw std::runtime_error("Invalid binary input: made for another circuit\n");
+  }
+  uint n = get_main_input_signal_no();
+  if (header.nSignals != n || input.size() != sizeof(header) + n*Fr_N64*8) {
+    throw std::runtime_error("Invalid binary input: wrong number of signals\n");
+  }
+  // the file is little endian as the limbs of a FrRawElement
+  const char *p = input.data() + sizeof(header);
+  PFrElement values = &ctx->signalValues[get_main_input_signal_start()];
+  for (uint i = 0; i < n; i++, p += Fr_N64*8) {
+    FrRawElement v;
+    memcpy(v, p, Fr_N64*8);
+    int j = Fr_N64 - 1;
+    while (j > 0 && v[j] == Fr_rawq[j]) j--;
+    if (v[j] >= Fr_rawq[j]) {
+      std::ostringstream errStrStream;
+      errStrStream << "Invalid binary input: value of signal " << get_main_input_signal_start() + i << " is not below q\n";
+      throw std::runtime_error(errStrStream.str() );
+    }
+    raw2element(&values[i], v);
+  }
+  ctx->setInputSignalsAssigned();
+  ctx->tryRunCircuit();
+}
+
+void loadInput(Circom_CalcWit *ctx, std::string filename) {
+  std::ifstream inStream(filename, std::ios::binary);
+  if (!inStream) {
+    throw std::runtime_error("Cannot open input file " + filename + "\n");
+  }
+  std::stringstream input;
+  input << inStream.rdbuf();
+  std::string const &s = input.str();
+  if (isBinInput(s)) {
+    loadBinInput(ctx, s);
+  } else {
+    loadJsonInput(ctx, s);
+  }
+}
+
+void json2BinInput(Circom_CalcWit *ctx, std::string const &input, std::string &bin) {
+  ctx->reset();
+  loadJsonInput(ctx, input, false);
+  if (ctx->getRemaingInputsToBeSet()!=0) {
+    std::ostringstream errStrStream;
+    errStrStream << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << "\n";
+    throw std::runtime_error(errStrStream.str() );
+  }
+  BinInputHeader header;
+  memcpy(header.magic, BIN_INPUT_MAGIC, 4);
+  header.version = BIN_INPUT_VERSION;
+  header.inputHash = ctx->getInputHash();
+  header.nSignals = get_main_input_signal_no();
+  bin.assign((char *)&header, sizeof(header));
+  PFrElement values = &ctx->signalValues[get_main_input_signal_start()];
+  for (uint i = 0; i < header.nSignals; i++) {
+    FrElement v;
+    Fr_toLongNormal(&v, &values[i]);
+    bin.append((char *)v.longVal, Fr_N64*8);
+  }
+}
+
+// .wtns v2: magic, version, number of sections, header section with the
+// prime and the number of witnesses, data section with the witnesses. The
+// Montgomery variant appends R to the header section.
+static size_t getBinWitnessHeaderSize(bool montgomery) {
+    return 4+4+4 + 4+8+4+Fr_N64*8+4 + (montgomery ? Fr_N64*8 : 0) + 4+8;
+}
+
+size_t getBinWitnessSize(bool montgomery) {
+    return getBinWitnessHeaderSize(montgomery) + (size_t)get_size_of_witness()*Fr_N64*8;
+}
+
+template <class T>
+static u8 *putBinWitness(u8 *p, T v) {
+    memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+void fillBinWitness(Circom_CalcWit *ctx, u8 *buf, bool montgomery) {
+    u8 *p = buf;
+    memcpy(p, "wtns", 4);
+    p += 4;
+    p = putBinWitness<u32>(p, montgomery ? WTNS_MONTGOMERY_VERSION : 2); // version
+    p = putBinWitness<u32>(p, 2); // nSections
+
+    // Header
+    u32 n8 = Fr_N64*8;
+    p = putBinWitness<u32>(p, 1);
+    p = putBinWitness<u64>(p, 8 + n8 + (montgomery ? n8 : 0));
+    p = putBinWitness<u32>(p, n8);
+    memcpy(p, Fr_q.longVal, n8);
+    p += n8;
+    uint Nwtns = get_size_of_witness();
+    p = putBinWitness<u32>(p, Nwtns);
+    if (montgomery) {
+        FrElement R = {1, Fr_SHORT, {0, 0, 0, 0}};
+        Fr_toMontgomery(&R, &R);
+        memcpy(p, R.longVal, n8);
+        p += n8;
+    }
+
+    // Data
+    p = putBinWitness<u32>(p, 2);
+    p = putBinWitness<u64>(p, (u64)n8*(u64)Nwtns);
+    assert(p == buf + getBinWitnessHeaderSize(montgomery));
+
+    ctx->getWitnessLong(p, montgomery);
+}
+
+void writeBinWitness(Circom_CalcWit *ctx, FILE *write_ptr, bool montgomery) {
+    std::vector<u8> buf(getBinWitnessSize(montgomery));
+    fillBinWitness(ctx, buf.data(), montgomery);
+    fwrite(buf.data(), buf.size(), 1, write_ptr);
+}
+
+void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName, bool montgomery) {
+    std::vector<u8> buf(getBinWitnessSize(montgomery));
+    fillBinWitness(ctx, buf.data(), montgomery);
+
+    int fd = open(wtnsFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+    const u8 *p = buf.data();
+    size_t n = buf.size();
+    while (n > 0) {
+        ssize_t r = write(fd, p, n);
+        if (r == -1 && errno == EINTR) continue;
+        if (r == -1) {
+            close(fd);
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+        p += r;
+        n -= r;
+    }
+    close(fd);
+}
+
+void calcWitness(Circom_CalcWit *ctx, std::string const &input, std::string &wtns, bool montgomery) {
+  ctx->reset();
+  if (isBinInput(input)) {
+    loadBinInput(ctx, input);
+  } else {
+    loadJsonInput(ctx, input);
+  }
+  if (ctx->getRemaingInputsToBeSet()!=0) {
+    std::ostringstream errStrStream;
+    errStrStream << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << "\n";
+    throw std::runtime_error(errStrStream.str() );
+  }
+  wtns.resize(getBinWitnessSize(montgomery));
+  fillBinWitness(ctx, (u8 *)&wtns[0], montgomery);
+}
+
+void precomputeWitness(Circom_CalcWit *ctx, std::string const &offline) {
+  ctx->reset();
+  loadJsonInput(ctx, offline, false);
+  if (ctx->getRemaingInputsToBeSet()==0) {
+    throw std::runtime_error("All inputs have been set, nothing is left to compute online\n");
+  }
+  if (!ctx->precomputeCircuit()) {
+    throw std::runtime_error("Not all the inputs needed to precompute the witness have been set\n");
+  }
+}
+
+void calcWitnessOnline(Circom_CalcWit *ctx, std::string const &online, std::string &wtns, bool montgomery) {
+  if (!ctx->precomputed || ctx->getRemaingInputsToBeSet()==0) {
+    throw std::runtime_error("The witness has not been precomputed\n");
+  }
+  loadJsonInput(ctx, online);
+  if (ctx->getRemaingInputsToBeSet()!=0) {
+    std::ostringstream errStrStream;
+    errStrStream << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << "\n";
+    throw std::runtime_error(errStrStream.str() );
+  }
+  wtns.resize(getBinWitnessSize(montgomery));
+  fillBinWitness(ctx, (u8 *)&wtns[0], montgomery);
+}
+
+uint threadsPerContext(uint nContexts) {
+  uint cores = std::thread::hardware_concurrency();
+  if (nContexts == 0 || cores <= nContexts) return 1;
+  return cores / nContexts;
+}
+
+void runWitnessBatch(Circom_Circuit *circuit, uint n, uint nThreads, std::function<void(Circom_CalcWit *ctx, uint i)> const &job) {
+  if (nThreads == 0) nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+  if (nThreads > n) nThreads = n;
+  std::atomic<uint> next(0);
+  uint maxThread = threadsPerContext(nThreads);
+  std::vector<std::thread> workers;
+  for (uint t = 0; t < nThreads; t++) {
+    workers.push_back(std::thread([circuit, n, maxThread, &next, &job]() {
+      Circom_CalcWit *ctx = new Circom_CalcWit(circuit, maxThread);
+      for (uint i = next++; i < n; i = next++) {
+        job(ctx, i);
+      }
+      delete ctx;
+    }));
+  }
+  for (uint t = 0; t < nThreads; t++) {
+    workers[t].join();
+  }
+}
+
+void calcWitnessBatch(Circom_Circuit *circuit, std::vector<std::string> const &inputs,
+                      std::vector<std::string> &wtns, std::vector<std::string> &errors, uint nThreads) {
+  uint n = inputs.size();
+  wtns.assign(n, std::string());
+  errors.assign(n, std::string());
+  runWitnessBatch(circuit, n, nThreads, [&inputs, &wtns, &errors](Circom_CalcWit *ctx, uint i) {
+    try {
+      calcWitness(ctx, inputs[i], wtns[i]);
+    } catch (std::exception &e) {
+      errors[i] = e.what();
+    }
+  });
+}
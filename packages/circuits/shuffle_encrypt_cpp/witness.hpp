@@ -0,0 +1,97 @@
+#ifndef CIRCOM_WITNESS_H
+#define CIRCOM_WITNESS_H
+
+#include <stdio.h>
+#include <string>
+#include <istream>
+#include <vector>
+#include <functional>
+
+#include "circom.hpp"
+#include "calcwit.hpp"
+
+Circom_Circuit* loadCircuit(std::string const &datFileName);
+// Unmaps the .dat file and frees what loadCircuit built from it. No context
+// of the circuit may be left.
+void freeCircuit(Circom_Circuit *circuit);
+
+// Besides arrays of values, a square matrix input of n*n values can be
+// given as {"permutation": [p0, ..., pn-1]}: row i is all 0 but for a 1 in
+// column pi. The indices must be a permutation of 0..n-1.
+void loadJson(Circom_CalcWit *ctx, std::istream &inStream);
+void loadJson(Circom_CalcWit *ctx, std::string filename);
+
+// Binary input: a BinInputHeader followed by the values of the main inputs
+// in signal order from get_main_input_signal_start(), each one a 32-byte
+// little-endian number below q.
+#define BIN_INPUT_MAGIC "cinp"
+#define BIN_INPUT_VERSION 1
+
+struct __attribute__((__packed__)) BinInputHeader {
+  char magic[4];
+  u32 version;
+  u64 inputHash; // Circom_CalcWit::getInputHash() of the circuit
+  u64 nSignals;
+};
+
+bool isBinInput(std::string const &input);
+void loadBinInput(Circom_CalcWit *ctx, std::string const &input);
+
+// Loads a JSON or binary input file, told apart by the binary magic.
+void loadInput(Circom_CalcWit *ctx, std::string filename);
+
+// Resets ctx and converts the JSON input into the binary input bin without
+// running the circuit. Throws std::runtime_error on invalid or incomplete
+// inputs.
+void json2BinInput(Circom_CalcWit *ctx, std::string const &input, std::string &bin);
+
+// With montgomery the .wtns file holds the witnesses in Montgomery form, as
+// they are in signalValues, and the header section gets R = 2^256 mod q
+// after the number of witnesses. Its version is WTNS_MONTGOMERY_VERSION
+// instead of 2, so readers that do not know the format refuse the file
+// rather than reading wrong values. This saves the two conversions for
+// provers that work in Montgomery form.
+#define WTNS_MONTGOMERY_VERSION 0x102
+
+// Size of the .wtns file of a witness.
+size_t getBinWitnessSize(bool montgomery = false);
+
+// Fills buf, getBinWitnessSize() bytes, with the .wtns file of the witness
+// computed in ctx. The witnesses are normalized on ctx->pool.
+void fillBinWitness(Circom_CalcWit *ctx, u8 *buf, bool montgomery = false);
+
+// Write the .wtns file with a single write.
+void writeBinWitness(Circom_CalcWit *ctx, FILE *write_ptr, bool montgomery = false);
+void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName, bool montgomery = false);
+
+// Number of subcomponent threads (Circom_CalcWit maxThread) for each of
+// nContexts contexts computing witnesses at the same time, so that together
+// they use about one thread per core.
+uint threadsPerContext(uint nContexts);
+
+// Resets ctx and computes the witness of the JSON or binary input into wtns
+// (.wtns file contents). Throws std::runtime_error on invalid or incomplete
+// inputs.
+void calcWitness(Circom_CalcWit *ctx, std::string const &input, std::string &wtns, bool montgomery = false);
+
+// Witness in two steps, for inputs that are partly known in advance.
+// precomputeWitness resets ctx, loads the JSON input offline, which must set
+// pk, A and R but not all the inputs, and runs the subcomponents that only
+// depend on them: the permutation check and r*G and r*pk of every card.
+// calcWitnessOnline loads the JSON input online with the other inputs into
+// the same ctx and computes the rest of the witness. Both throw
+// std::runtime_error on invalid or incomplete inputs.
+void precomputeWitness(Circom_CalcWit *ctx, std::string const &offline);
+void calcWitnessOnline(Circom_CalcWit *ctx, std::string const &online, std::string &wtns, bool montgomery = false);
+
+// Runs job(ctx, i) for every i < n on a fixed pool of nThreads workers (0 for
+// one per core). The workers share the read-only circuit and each one reuses
+// its own context for all the jobs it takes.
+void runWitnessBatch(Circom_Circuit *circuit, uint n, uint nThreads, std::function<void(Circom_CalcWit *ctx, uint i)> const &job);
+
+// Computes the witnesses of all the inputs with runWitnessBatch. wtns[i]
+// gets the .wtns contents for inputs[i], or errors[i] the reason it failed.
+void calcWitnessBatch(Circom_Circuit *circuit, std::vector<std::string> const &inputs,
+                      std::vector<std::string> &wtns, std::vector<std::string> &errors, uint nThreads);
+
+#endif // CIRCOM_WITNESS_H